@@ -1,10 +1,17 @@
 #include "gomoku_ai.h"
+#include "gomoku_patterns.h"
+#include "gomoku_book.h"
 #include <algorithm>
 #include <climits>
 #include <cstring>
 #include <set>
 #include <random>
 #include <iostream>
+#include <atomic>
+
+#ifdef GOMOKU_THREADS
+#include <thread>
+#endif
 
 #ifdef DEBUG_AI_LOGS
 #include <emscripten.h>
@@ -12,6 +19,8 @@
 
 static GomokuAI *globalAI = nullptr;
 
+SearchStats searchStats;
+
 GomokuAI *getGlobalAI()
 {
     return globalAI;
@@ -32,11 +41,54 @@ const int CENTERALITY_BONUS = 50;
 const float DEFENSE_MULTIPLIER = 1.2f;
 const float CAPTURE_PRIORITY_MULTIPLIER = 1.1f;
 
-const int CANDIDATES_SIZE = 50;
 const int MAX_ROOT_CANDIDATES = 6;
 const int MAX_LEAFT_CANDIDATES = 8;
 const int MINI_MAX_DEPTH = 10;
 
+// Prolongation de quiescence à l'horizon : captures uniquement, bornée en plis
+const int QUIESCENCE_MAX_PLY = 6;
+
+// Cadre d'élagage de minimax : coup nul (passer le trait, réfuter à
+// profondeur réduite), futilité aux nœuds frontière, réduction des coups
+// tardifs. Passer étant toujours perdant au Gomoku (pas de zugzwang), le
+// coup nul y est sûr.
+const int NULL_MOVE_MIN_DEPTH = 3;
+const int FUTILITY_MARGIN = SCORE_LIVE_THREE; // swing max toléré d'un coup calme
+const int LMR_MIN_DEPTH = 3;
+const int LMR_FIRST_REDUCED = 3; // coups triés déjà cherchés avant de réduire
+
+// Le hash ne code pas le trait (l'alternance stricte le rend implicite) ;
+// un sous-arbre de coup nul brise cette alternance, sa parité est donc
+// repliée dans les clés (les 8 images) le temps du sous-arbre.
+const uint64_t NULL_SIDE_KEY = 0xF0E1D2C3B4A59687ULL;
+
+// Approfondissement itératif : budget temps par défaut (aligné sur le budget
+// UI de 500 ms) et fréquence de vérification de l'horloge dans minimax.
+const int DEFAULT_TIME_BUDGET_MS = 500;
+const int TIME_CHECK_INTERVAL = 1024;
+
+// Évaluation par playouts : nombre de parties aléatoires par feuille, borne
+// de longueur d'une partie, et échelle du verdict (un score de victoire
+// certaine reste sous SCORE_FIVE pour ne pas concurrencer les gains réels).
+const int PLAYOUT_COUNT = 200;
+const int PLAYOUT_MAX_PLIES = 40;
+const int PLAYOUT_SCORE_SCALE = SCORE_LIVE_THREE;
+
+// Recherche dans l'espace des menaces (VCF) : l'arbre restreint aux coups
+// forçants est assez étroit pour être fouillé bien au-delà de MINI_MAX_DEPTH,
+// sur une fraction du budget seulement.
+const int THREAT_MAX_PLIES = 24;
+const int THREAT_BUDGET_DIVISOR = 4;   // part du budget total allouée au VCF
+const int THREAT_CHECK_INTERVAL = 256; // fréquence de vérification de l'horloge
+
+// Solveur de course aux captures : déclenché quand un camp est à deux paires
+// de la victoire par captures. L'arbre restreint aux captures et à leurs
+// parades est minuscule ; la table de mémoïsation absorbe les transpositions.
+const int RACE_TRIGGER_STONES = MAX_CAPTURE_STONES - 4; // deux paires restantes
+const int RACE_MAX_PLIES = 12;
+const int RACE_BUDGET_DIVISOR = 16; // part du budget allouée au solveur
+const int RACE_TABLE_BITS = 14;     // 16 384 entrées (~256 Ko)
+
 #ifdef DEBUG_AI_LOGS
 
 void logMoveAnalysis(int row, int col, int player, int score, bool isBestMove = false)
@@ -69,7 +121,236 @@ void logMoveAnalysis(int row, int col, int player, int score, bool isBestMove =
 
 // Zobrist hashing - Ai brain, to remember pattern and avoid double computation
 uint64_t zobristTable[BOARD_SIZE][BOARD_SIZE][3];
-std::unordered_map<uint64_t, TTEntry> transpositionTable;
+
+// =================================================================================
+//                      SYMÉTRIES DU PLATEAU (CLÉ CANONIQUE)
+// =================================================================================
+//
+// Le plateau a une symétrie d'ordre 8 (4 rotations × miroir). En phase
+// d'ouverture, sonder et écrire la table de transposition sous la clé
+// canonique (minimum des 8 hash) fusionne les 8 orientations d'une même
+// position. Les coups stockés sont exprimés dans le repère canonique et
+// reconvertis à la sonde ; passé CANONICAL_MAX_STONES pierres, le coût des
+// orientations dupliquées devient négligeable et la clé redevient currentHash.
+
+const int CANONICAL_MAX_STONES = 12;
+
+// Transformation s appliquée à une case (s = 0 : identité ; 1..3 : rotations
+// de 90/180/270° ; 4..5 : miroirs ; 6..7 : transpositions)
+static inline int symApplyIdx(int s, int idx)
+{
+    if (idx < 0)
+        return idx;
+
+    int r = idx / BOARD_SIZE;
+    int c = idx % BOARD_SIZE;
+    const int n = BOARD_SIZE - 1;
+
+    switch (s)
+    {
+    case 1:
+        return c * BOARD_SIZE + (n - r);
+    case 2:
+        return (n - r) * BOARD_SIZE + (n - c);
+    case 3:
+        return (n - c) * BOARD_SIZE + r;
+    case 4:
+        return r * BOARD_SIZE + (n - c);
+    case 5:
+        return (n - r) * BOARD_SIZE + c;
+    case 6:
+        return c * BOARD_SIZE + r;
+    case 7:
+        return (n - c) * BOARD_SIZE + (n - r);
+    }
+    return idx;
+}
+
+// Transformation inverse (seules les rotations de 90 et 270° ne sont pas
+// leur propre inverse)
+static const int SYM_INVERSE[8] = {0, 3, 2, 1, 4, 5, 6, 7};
+
+// =================================================================================
+//                      TABLE DE TRANSPOSITION (TABLEAU PLAT)
+// =================================================================================
+//
+// Table à adressage direct, taille fixe en puissance de 2 : une sonde touche
+// exactement une entrée de 16 octets (une ligne de cache), mémoire bornée
+// quelle que soit la durée de la session. Remplacement par profondeur au sein
+// d'une génération, les générations précédentes sont toujours écrasées.
+
+const int DEFAULT_TT_SIZE_MB = 32;
+
+struct PackedTTEntry
+{
+    uint32_t key32; // bits hauts du hash, vérification de collision
+    int32_t score;
+    int16_t depth; // -1 : entrée vide
+    uint8_t flag;  // 0: EXACT, 1: ALPHA, 2: BETA
+    uint8_t age;   // génération de recherche
+    uint16_t bestMove;
+    uint16_t pad;
+};
+
+static PackedTTEntry *ttTable = nullptr;
+static uint64_t ttMask = 0;
+static uint8_t ttGeneration = 0;
+
+void resizeTranspositionTable(int mb)
+{
+    if (mb < 1)
+        mb = 1;
+
+    uint64_t entries = ((uint64_t)mb << 20) / sizeof(PackedTTEntry);
+    uint64_t pow2 = 1;
+    while (pow2 * 2 <= entries)
+        pow2 *= 2;
+
+    delete[] ttTable;
+    ttTable = new PackedTTEntry[pow2];
+    ttMask = pow2 - 1;
+
+    for (uint64_t i = 0; i <= ttMask; i++)
+        ttTable[i].depth = -1;
+}
+
+static bool ttProbe(uint64_t hash, TTEntry &out)
+{
+    const PackedTTEntry &e = ttTable[hash & ttMask];
+    if (e.depth < 0 || e.key32 != (uint32_t)(hash >> 32))
+        return false;
+
+    out.depth = e.depth;
+    out.score = e.score;
+    out.flag = e.flag;
+    out.bestMove = (e.bestMove == 0) ? -1 : e.bestMove - 1;
+    return true;
+}
+
+static void ttStore(uint64_t hash, int depth, int score, int flag, int bestMove)
+{
+    PackedTTEntry &e = ttTable[hash & ttMask];
+
+    // On préserve une entrée plus profonde de la génération courante pour une
+    // autre position ; tout le reste (vide, génération passée, moins profond,
+    // même position) est remplacé.
+    if (e.depth >= 0 && e.age == ttGeneration && e.depth > depth &&
+        e.key32 != (uint32_t)(hash >> 32))
+        return;
+
+    e.key32 = (uint32_t)(hash >> 32);
+    e.score = score;
+    e.depth = (int16_t)depth;
+    e.flag = (uint8_t)flag;
+    e.age = ttGeneration;
+    e.bestMove = (uint16_t)(bestMove < 0 ? 0 : bestMove + 1);
+}
+
+// =================================================================================
+//                      RECHERCHE MULTI-THREAD (LAZY SMP)
+// =================================================================================
+//
+// N-1 instances auxiliaires fouillent la même racine que le thread principal
+// avec des profondeurs de départ décalées. Leurs résultats sont jetés : le
+// gain vient du remplissage partagé de la table de transposition. Les écritures
+// concurrentes dans la table sont volontairement sans verrou ; la clé de
+// vérification 32 bits filtre les entrées déchirées.
+
+static int searchThreadCount = 1;
+static std::atomic<bool> smpStop(false);
+
+#ifdef GOMOKU_THREADS
+static std::vector<GomokuAI *> helperPool;
+
+// Thread de réflexion sur le temps adverse (voir startPondering)
+static std::thread ponderThread;
+static bool ponderActive = false;
+#endif
+
+// Dos d'évaluation courant, partagé comme searchThreadCount : les auxiliaires
+// SMP et le thread principal basculent ensemble.
+static int evaluationMode = EVAL_STATIC;
+
+// Enveloppe de force réglable à l'exécution (un seul binaire pour tous les
+// produits) : budget de nœuds (0 = illimité), profondeur maximale et largeurs
+// de candidats racine/feuille. Les constantes de compilation restent les
+// valeurs par défaut.
+static long long searchNodeBudget = 0;
+static int searchMaxDepth = MINI_MAX_DEPTH;
+static int rootCandidateLimit = MAX_ROOT_CANDIDATES;
+static int leafCandidateLimit = MAX_LEAFT_CANDIDATES;
+
+void setSearchBudget(long long nodes, int maxDepth, int maxCandidates)
+{
+    searchNodeBudget = (nodes > 0) ? nodes : 0;
+
+    // Plafond dimensionné par les structures indexées en profondeur
+    // (killers, temps par itération, listes par pli : PLY_LIST_COUNT
+    // entrées), quiescence comprise : au-delà de PLY_LIST_COUNT -
+    // QUIESCENCE_MAX_PLY - 1, les plis terminaux se rabattraient tous sur
+    // la dernière liste et un enfant écraserait la liste vivante du parent.
+    searchMaxDepth = (maxDepth > 0) ? maxDepth : MINI_MAX_DEPTH;
+    if (searchMaxDepth > PLY_LIST_COUNT - QUIESCENCE_MAX_PLY - 1)
+        searchMaxDepth = PLY_LIST_COUNT - QUIESCENCE_MAX_PLY - 1;
+
+    if (maxCandidates > 0)
+    {
+        leafCandidateLimit = std::min(maxCandidates, BOARD_SIZE * BOARD_SIZE);
+        rootCandidateLimit = std::min(maxCandidates, BOARD_SIZE * BOARD_SIZE);
+    }
+    else
+    {
+        leafCandidateLimit = MAX_LEAFT_CANDIDATES;
+        rootCandidateLimit = MAX_ROOT_CANDIDATES;
+    }
+}
+
+void setEvaluationMode(int mode)
+{
+    evaluationMode = (mode == EVAL_PLAYOUT) ? EVAL_PLAYOUT : EVAL_STATIC;
+}
+
+// Annulation coopérative : le drapeau peut être armé depuis n'importe quel
+// thread (pont, superviseur) pendant qu'une recherche tourne ; il est relevé
+// par le test d'horloge amorti et traité exactement comme l'épuisement du
+// budget temps — la recherche rend son meilleur coup courant. Réarmé à
+// chaque nouvelle recherche du thread principal.
+static std::atomic<bool> searchCancelled(false);
+
+void cancelActiveSearch()
+{
+    searchCancelled.store(true, std::memory_order_relaxed);
+}
+
+// Tampon de progression : le thread principal y publie l'avancement à chaque
+// itération terminée (séquence, profondeur, meilleur coup, score) et à chaque
+// quantum d'horloge (nœuds). De simples écritures d'entiers — aucun rappel
+// vers l'hôte pendant la recherche ; un lecteur externe (mémoire wasm
+// partagée, thread natif) sonde le tampon directement. Écriture mono-thread,
+// lecture tolérante au déchirement : l'instantané n'est qu'indicatif.
+int searchProgressBuffer[SEARCH_PROGRESS_SLOTS] = {0};
+
+const int PROGRESS_SEQ = 0;
+const int PROGRESS_DEPTH = 1;
+const int PROGRESS_ROW = 2;
+const int PROGRESS_COL = 3;
+const int PROGRESS_SCORE = 4;
+const int PROGRESS_NODES = 5;
+const int PROGRESS_RUNNING = 6;
+
+void setSearchThreads(int threads)
+{
+#ifdef GOMOKU_THREADS
+    if (threads < 1)
+        threads = 1;
+    if (threads > 32)
+        threads = 32;
+    searchThreadCount = threads;
+#else
+    (void)threads;
+    searchThreadCount = 1;
+#endif
+}
 
 void initZobrist()
 {
@@ -85,39 +366,105 @@ void initZobrist()
     initialized = true;
 }
 
-GomokuAI::GomokuAI(int aiPlayerColor)
+GomokuAI::GomokuAI(int aiPlayerColor, bool registerGlobal, bool helper)
 {
     this->aiPlayer = aiPlayerColor;
     this->humanPlayer = (aiPlayerColor == BLACK) ? WHITE : BLACK;
+    this->searchAborted = false;
+    this->timeCheckCounter = 0;
+    this->lastSearchScore = 0;
+    this->undoDepth = 0;
+    this->isHelper = helper;
+    this->playoutRng.seed(0x9E3779B9u);
     initZobrist();
+    initPatternTables();
+    if (ttTable == nullptr)
+        resizeTranspositionTable(DEFAULT_TT_SIZE_MB);
     clearBoard();
-    globalAI = this;
+    if (registerGlobal)
+        globalAI = this;
+}
+
+// Discontinuité de position (nouvelle partie ou resynchronisation complète) :
+// le contexte d'ordonnancement accumulé — killers et historique — ne décrit
+// plus l'arbre à venir et repart de zéro. En continuation de partie (delta
+// de coups), il est au contraire conservé d'une recherche à l'autre.
+void GomokuAI::resetSearchContext()
+{
+    memset(killerMoves, -1, sizeof(killerMoves));
+    memset(historyTable, 0, sizeof(historyTable));
 }
 
 void GomokuAI::clearBoard()
 {
     memset(board, NONE, sizeof(board));
+    planes[BLACK].clear();
+    planes[WHITE].clear();
     gameState = GameState();
-    while (!moveHistory.empty())
-        moveHistory.pop();
-    stateHistory.clear();
+    undoDepth = 0;
+    resetSearchContext();
+
+    // Convention de hachage : chaque case contribue sa clé, y compris NONE.
+    // make/undo bascule NONE ↔ couleur ; le hash d'une position est ainsi le
+    // même qu'elle soit atteinte en delta ou par resynchronisation complète.
     currentHash = 0;
+    for (int i = 0; i < BOARD_SIZE; i++)
+        for (int j = 0; j < BOARD_SIZE; j++)
+            currentHash ^= zobristTable[i][j][NONE];
+
+    // Le plateau vide est invariant par symétrie : les 8 hash coïncident
+    for (int s = 0; s < 7; s++)
+        symHashes[s] = currentHash;
+    stoneCount = 0;
+
+    evalDirty = true;
+    rebuildNeighborCounts();
+    rebuildCaptureIndex();
+    rebuildArbiterCaches();
 }
 
 void GomokuAI::setBoard(const int *flatBoard, int blackCaptures, int whiteCaptures)
 {
+    planes[BLACK].clear();
+    planes[WHITE].clear();
+
     for (int i = 0; i < BOARD_SIZE; i++)
         for (int j = 0; j < BOARD_SIZE; j++)
+        {
             board[i][j] = flatBoard[i * BOARD_SIZE + j];
+            if (board[i][j] != NONE)
+                planes[board[i][j]].set(i, j);
+        }
 
     gameState.capturedByBlack = blackCaptures;
     gameState.capturedByWhite = whiteCaptures;
+    resetSearchContext();
 
+    // Même convention que clearBoard : toutes les cases contribuent (clé NONE
+    // pour les vides), pour que delta et resynchronisation donnent le même hash
     currentHash = 0;
+    for (int s = 0; s < 7; s++)
+        symHashes[s] = 0;
+    stoneCount = 0;
+
     for (int i = 0; i < BOARD_SIZE; i++)
         for (int j = 0; j < BOARD_SIZE; j++)
+        {
+            currentHash ^= zobristTable[i][j][board[i][j]];
+            for (int s = 1; s <= 7; s++)
+            {
+                int idx = symApplyIdx(s, i * BOARD_SIZE + j);
+                symHashes[s - 1] ^=
+                    zobristTable[idx / BOARD_SIZE][idx % BOARD_SIZE][board[i][j]];
+            }
             if (board[i][j] != NONE)
-                currentHash ^= zobristTable[i][j][board[i][j]];
+                stoneCount++;
+        }
+
+    evalDirty = true;
+    rebuildNeighborCounts();
+    rebuildCaptureIndex();
+    rebuildArbiterCaches();
 }
 
 bool GomokuAI::isValidMove(int row, int col)
@@ -126,6 +473,11 @@ bool GomokuAI::isValidMove(int row, int col)
 }
 
 void GomokuAI::getBestMove(int &bestRow, int &bestCol)
+{
+    getBestMoveTimed(DEFAULT_TIME_BUDGET_MS, bestRow, bestCol);
+}
+
+void GomokuAI::getBestMoveTimed(int budgetMs, int &bestRow, int &bestCol)
 {
 
 #ifdef DEBUG_AI_LOGS
@@ -134,11 +486,33 @@ void GomokuAI::getBestMove(int &bestRow, int &bestCol)
 
     bestRow = bestCol = -1;
 
-    int stoneCount = 0;
-    for (int i = 0; i < BOARD_SIZE; i++)
-        for (int j = 0; j < BOARD_SIZE; j++)
-            if (board[i][j] != NONE)
-                stoneCount++;
+    if (!isHelper)
+    {
+        // Une recherche réelle prend toujours la main sur le ponder en cours
+        stopPondering();
+        searchStats.reset();
+
+        // Réarmement de l'annulation et remise à zéro de la progression
+        // (les sorties instantanées — livre, coup gagnant — laissent le
+        // tampon au repos)
+        searchCancelled.store(false, std::memory_order_relaxed);
+        for (int i = 0; i < SEARCH_PROGRESS_SLOTS; i++)
+            searchProgressBuffer[i] = 0;
+        searchProgressBuffer[PROGRESS_ROW] = -1;
+        searchProgressBuffer[PROGRESS_COL] = -1;
+    }
+    lastSearchScore = 0;
+
+    // Continuation de partie : les killers de la recherche précédente sont
+    // conservés tels quels (indexés par profondeur restante, ils restent
+    // pertinents deux plis plus loin et sont de toute façon revalidés avant
+    // d'être joués) ; l'historique est vieilli de moitié pour que les
+    // coupures récentes dominent sans perdre l'acquis. Le contexte n'est
+    // remis à zéro que sur une discontinuité (setBoard / clearBoard).
+    for (int p = BLACK; p <= WHITE; p++)
+        for (int r = 0; r < BOARD_SIZE; r++)
+            for (int c = 0; c < BOARD_SIZE; c++)
+                historyTable[p][r][c] >>= 1;
 
     if (stoneCount == 0)
     {
@@ -166,7 +540,37 @@ void GomokuAI::getBestMove(int &bestRow, int &bestCol)
         return;
     }
 
-    std::vector<Move> candidates = getCandidateMoves(aiPlayer);
+    // Sonde du livre d'ouvertures : tant que la phase d'ouverture est
+    // couverte, le coup distillé du self-play remplace toute recherche. Le
+    // coup est revalidé contre la position vivante — un livre d'une autre
+    // variante de règles ne peut pas produire un coup illégal.
+    if (stoneCount <= BOOK_MAX_STONES)
+    {
+        int bookMove = openingBook.probe(bookKey(currentHash, aiPlayer));
+        if (bookMove >= 0 && bookMove < BOARD_SIZE * BOARD_SIZE)
+        {
+            int r = bookMove / BOARD_SIZE;
+            int c = bookMove % BOARD_SIZE;
+            if (GomokuRules::validateMove(board, r, c, aiPlayer) == VALID)
+            {
+                bestRow = r;
+                bestCol = c;
+#ifdef DEBUG_AI_LOGS
+                logMoveAnalysis(bestRow, bestCol, aiPlayer, 0);
+#endif
+                return;
+            }
+        }
+    }
+
+    int rootCount = getCandidateMoves(aiPlayer, plyMoves[0]);
+    std::vector<Move> candidates(plyMoves[0], plyMoves[0] + rootCount);
+
+    // À la racine (une fois par tour), on filtre la légalité de suite
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [this](const Move &m)
+                                    { return GomokuRules::validateMove(board, m.row, m.col, aiPlayer) != VALID; }),
+                     candidates.end());
 
     // Store ALL candidates for Debug Heatmap (Type 0 = Yellow)
     aiCandidateMoves = candidates;
@@ -182,13 +586,16 @@ void GomokuAI::getBestMove(int &bestRow, int &bestCol)
     for (Move &move : candidates)
     {
         board[move.row][move.col] = aiPlayer;
+        planes[aiPlayer].set(move.row, move.col);
         bool aiWins = checkWinQuick(move.row, move.col, aiPlayer);
+        planes[aiPlayer].reset(move.row, move.col);
         board[move.row][move.col] = NONE;
 
         if (aiWins)
         {
             bestRow = move.row;
             bestCol = move.col;
+            lastSearchScore = SCORE_FIVE;
             // Mark winning move as Type 2 (Purple - One Shot)
             for (auto &dm : aiCandidateMoves)
             {
@@ -206,7 +613,9 @@ void GomokuAI::getBestMove(int &bestRow, int &bestCol)
         }
 
         board[move.row][move.col] = humanPlayer;
+        planes[humanPlayer].set(move.row, move.col);
         bool oppWins = checkWinQuick(move.row, move.col, humanPlayer);
+        planes[humanPlayer].reset(move.row, move.col);
         board[move.row][move.col] = NONE;
 
         if (oppWins)
@@ -244,32 +653,331 @@ void GomokuAI::getBestMove(int &bestRow, int &bestCol)
         }
     }
 
-    int depth = MINI_MAX_DEPTH;
+    if (budgetMs <= 0)
+        budgetMs = DEFAULT_TIME_BUDGET_MS;
+
+    // Course aux captures : à deux paires de la victoire par captures, la
+    // position est une course pure que le solveur dédié résout exactement
+    // pour une fraction du budget — la recherche générale n'est payée qu'à
+    // défaut de victoire forcée.
+    if (gameState.capturedByBlack >= RACE_TRIGGER_STONES ||
+        gameState.capturedByWhite >= RACE_TRIGGER_STONES)
+    {
+        int raceR, raceC;
+        if (captureRaceSearch(budgetMs, raceR, raceC))
+        {
+            bestRow = raceR;
+            bestCol = raceC;
+            lastSearchScore = SCORE_FIVE;
+            for (auto &dm : aiCandidateMoves)
+            {
+                if (dm.row == raceR && dm.col == raceC)
+                {
+                    dm.score = SCORE_FIVE;
+                    dm.algoType = 2;
+                    break;
+                }
+            }
+#ifdef DEBUG_AI_LOGS
+            logMoveAnalysis(bestRow, bestCol, aiPlayer, SCORE_FIVE, true);
+#endif
+            return;
+        }
+    }
+
+    // Recherche dans l'espace des menaces : une victoire forcée par
+    // enchaînement de coups forçants (VCF) est jouée sans recherche
+    // générale — elle se trouve en quelques millisecondes à des profondeurs
+    // que l'approfondissement itératif n'atteindra jamais.
+    int threatR, threatC;
+    if (threatSpaceSearch(budgetMs, threatR, threatC))
+    {
+        bestRow = threatR;
+        bestCol = threatC;
+        lastSearchScore = SCORE_FIVE;
+        for (auto &dm : aiCandidateMoves)
+        {
+            if (dm.row == threatR && dm.col == threatC)
+            {
+                dm.score = SCORE_FIVE;
+                dm.algoType = 2;
+                break;
+            }
+        }
+#ifdef DEBUG_AI_LOGS
+        logMoveAnalysis(bestRow, bestCol, aiPlayer, SCORE_FIVE, true);
+#endif
+        return;
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Move &a, const Move &b)
+              { return a.score > b.score; });
+
+    // Seuls les meilleurs candidats heuristiques sont approfondis ; on tronque
+    // pour que les réordonnancements inter-itérations restent dans ce sous-ensemble.
+    if ((int)candidates.size() > rootCandidateLimit)
+        candidates.resize(rootCandidateLimit);
+
+    auto searchStart = std::chrono::steady_clock::now();
+    searchDeadline = searchStart + std::chrono::milliseconds(budgetMs);
+    searchAborted = false;
+    timeCheckCounter = 0;
+    if (!isHelper)
+    {
+        ttGeneration++;
+        searchProgressBuffer[PROGRESS_RUNNING] = 1;
+    }
+
+#ifdef GOMOKU_THREADS
+    // Lancement des auxiliaires Lazy SMP sur une copie de la position
+    std::vector<std::thread> helperThreads;
+    if (!isHelper && searchThreadCount > 1)
+    {
+        smpStop.store(false, std::memory_order_relaxed);
+
+        int flatBoard[BOARD_SIZE * BOARD_SIZE];
+        for (int i = 0; i < BOARD_SIZE; i++)
+            for (int j = 0; j < BOARD_SIZE; j++)
+                flatBoard[i * BOARD_SIZE + j] = board[i][j];
+
+        while ((int)helperPool.size() < searchThreadCount - 1)
+            helperPool.push_back(new GomokuAI(aiPlayer, false, true));
+
+        for (int t = 0; t < searchThreadCount - 1; t++)
+        {
+            GomokuAI *helper = helperPool[t];
+            if (helper->aiPlayer != aiPlayer)
+            {
+                helper->aiPlayer = aiPlayer;
+                helper->humanPlayer = humanPlayer;
+            }
+            helper->setBoard(flatBoard, gameState.capturedByBlack, gameState.capturedByWhite);
+
+            // Profondeurs de départ décalées pour désynchroniser les fronts
+            int startDepth = 1 + (t % 2);
+            auto deadline = searchDeadline;
+            helperThreads.emplace_back([helper, startDepth, deadline]()
+                                       { helper->helperSearch(startDepth, deadline); });
+        }
+    }
+#endif
+
+    // Approfondissement itératif : on creuse 1, 2, 3… plis jusqu'à épuisement
+    // du budget. Seule la dernière itération complète est retenue, et ses
+    // scores racine réordonnent les candidats de l'itération suivante.
+    for (int depth = 1; depth <= searchMaxDepth; depth++)
+    {
+        int iterRow, iterCol;
+        if (!searchRootIteration(depth, candidates, iterRow, iterCol))
+            break;
+
+        bestRow = iterRow;
+        bestCol = iterCol;
+
+        if (!isHelper && depth < 32)
+        {
+            searchStats.depthReached = depth;
+            searchStats.iterationMs[depth] =
+                std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - searchStart)
+                    .count();
+        }
+
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Move &a, const Move &b)
+                  { return a.score > b.score; });
+
+        // Publication de la progression : la séquence est incrémentée en
+        // dernier pour qu'un lecteur qui la voit bouger relise des champs
+        // cohérents avec cette itération
+        if (!isHelper)
+        {
+            searchProgressBuffer[PROGRESS_DEPTH] = depth;
+            searchProgressBuffer[PROGRESS_ROW] = bestRow;
+            searchProgressBuffer[PROGRESS_COL] = bestCol;
+            searchProgressBuffer[PROGRESS_SCORE] = candidates[0].score;
+            searchProgressBuffer[PROGRESS_NODES] =
+                (searchStats.nodes > INT_MAX) ? INT_MAX : (int)searchStats.nodes;
+            searchProgressBuffer[PROGRESS_SEQ]++;
+        }
+
+        // Victoire forcée trouvée : inutile de creuser davantage
+        if (candidates[0].score >= SCORE_FIVE)
+            break;
+    }
+
+    if (!isHelper)
+        searchProgressBuffer[PROGRESS_RUNNING] = 0;
+
+#ifdef GOMOKU_THREADS
+    if (!helperThreads.empty())
+    {
+        smpStop.store(true, std::memory_order_relaxed);
+        for (std::thread &t : helperThreads)
+            t.join();
+        smpStop.store(false, std::memory_order_relaxed);
+    }
+#endif
+
+    lastSearchScore = candidates[0].score;
+
+#ifdef DEBUG_AI_LOGS
+    logMoveAnalysis(bestRow, bestCol, aiPlayer, 0, true);
+#endif
+}
+
+// Boucle de recherche d'une instance auxiliaire : mêmes candidats, mêmes
+// itérations, résultat ignoré — seule la table de transposition partagée compte.
+void GomokuAI::helperSearch(int startDepth, std::chrono::steady_clock::time_point deadline)
+{
+    searchDeadline = deadline;
+    searchAborted = false;
+    timeCheckCounter = 0;
+
+    int rootCount = getCandidateMoves(aiPlayer, plyMoves[0]);
+    std::vector<Move> candidates(plyMoves[0], plyMoves[0] + rootCount);
+
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [this](const Move &m)
+                                    { return GomokuRules::validateMove(board, m.row, m.col, aiPlayer) != VALID; }),
+                     candidates.end());
+
+    if (candidates.empty())
+        return;
+
+    for (Move &move : candidates)
+        move.score = evaluateMoveQuick(move.row, move.col, aiPlayer);
 
     std::sort(candidates.begin(), candidates.end(),
               [](const Move &a, const Move &b)
               { return a.score > b.score; });
 
-    int maxCandidates = MAX_ROOT_CANDIDATES;
+    if ((int)candidates.size() > rootCandidateLimit)
+        candidates.resize(rootCandidateLimit);
+
+    for (int depth = startDepth; depth <= searchMaxDepth; depth++)
+    {
+        int iterRow, iterCol;
+        if (!searchRootIteration(depth, candidates, iterRow, iterCol))
+            break;
+
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Move &a, const Move &b)
+                  { return a.score > b.score; });
+
+        if (candidates[0].score >= SCORE_FIVE)
+            break;
+    }
+}
+
+// =================================================================================
+//                      RÉFLEXION SUR LE TEMPS ADVERSE (PONDER)
+// =================================================================================
+//
+// Une fois notre coup rendu, le moteur est inactif pendant que l'adversaire
+// réfléchit. startPondering lance un auxiliaire sur une copie de la position
+// courante : si la table de transposition connaît la réponse adverse la plus
+// probable, elle est jouée d'avance et l'auxiliaire cherche déjà notre
+// réplique. Ses résultats remplissent la table partagée — sur un ponder hit,
+// la recherche suivante retombe sur des entrées profondes déjà chaudes.
+
+void GomokuAI::startPondering()
+{
+#ifdef GOMOKU_THREADS
+    stopPondering();
+
+    std::vector<int> snapshot(BOARD_SIZE * BOARD_SIZE);
+    for (int i = 0; i < BOARD_SIZE; i++)
+        for (int j = 0; j < BOARD_SIZE; j++)
+            snapshot[i * BOARD_SIZE + j] = board[i][j];
+
+    // Réponse adverse prédite : le meilleur coup mémorisé pour la position
+    // courante (où l'adversaire a le trait), s'il existe
+    TTEntry entry;
+    int ponderSym = 0;
+    int predicted = (ttProbe(canonicalKey(ponderSym), entry) && entry.bestMove >= 0)
+                        ? symApplyIdx(SYM_INVERSE[ponderSym], entry.bestMove)
+                        : -1;
+
+    // Prédiction disponible : on cherche notre réplique dans la position
+    // résultante ; sinon on cherche le meilleur coup adverse.
+    int side = (predicted >= 0) ? aiPlayer : humanPlayer;
+    int replier = humanPlayer;
+    int bCaps = gameState.capturedByBlack;
+    int wCaps = gameState.capturedByWhite;
+
+    smpStop.store(false, std::memory_order_relaxed);
+    ponderActive = true;
+    ponderThread = std::thread([snapshot, predicted, side, replier, bCaps, wCaps]()
+                               {
+        GomokuAI ponder(side, false, true);
+        ponder.setBoard(snapshot.data(), bCaps, wCaps);
+        if (predicted >= 0)
+            ponder.applyMoveDelta(predicted / BOARD_SIZE, predicted % BOARD_SIZE, replier);
+        ponder.ponderLoop(); });
+#endif
+}
+
+void GomokuAI::stopPondering()
+{
+#ifdef GOMOKU_THREADS
+    if (!ponderActive)
+        return;
+
+    smpStop.store(true, std::memory_order_relaxed);
+    ponderThread.join();
+    smpStop.store(false, std::memory_order_relaxed);
+    ponderActive = false;
+#endif
+}
+
+// La prédiction s'est réalisée : la table partagée contient déjà la variation
+// principale approfondie. On arrête simplement l'auxiliaire — la recherche
+// qui suit la récolte via ses sondes TT.
+void GomokuAI::ponderHit()
+{
+    stopPondering();
+}
+
+// Corps du thread de ponder : approfondissement auxiliaire jusqu'à
+// MINI_MAX_DEPTH ou interruption par smpStop.
+void GomokuAI::ponderLoop()
+{
+    helperSearch(1, std::chrono::steady_clock::now() + std::chrono::hours(1));
+}
+
+bool GomokuAI::searchRootIteration(int depth, std::vector<Move> &candidates, int &outRow, int &outCol)
+{
+    int maxCandidates = std::min((int)candidates.size(), rootCandidateLimit);
 
     int alpha = -INT_MAX;
     int beta = INT_MAX;
 
+    outRow = candidates[0].row;
+    outCol = candidates[0].col;
+
     for (int i = 0; i < maxCandidates; i++)
     {
         makeMoveInternal(candidates[i].row, candidates[i].col, aiPlayer);
         int score = -minimax(depth - 1, -beta, -alpha, humanPlayer);
         undoMove();
 
+        // Budget épuisé : l'itération est incomplète, son résultat est jeté
+        if (searchAborted)
+            return false;
+
 #ifdef DEBUG_AI_LOGS
         logMoveAnalysis(candidates[i].row, candidates[i].col, aiPlayer, score);
 #endif
 
+        candidates[i].score = score;
+
         if (score > alpha)
         {
             alpha = score;
-            bestRow = candidates[i].row;
-            bestCol = candidates[i].col;
+            outRow = candidates[i].row;
+            outCol = candidates[i].col;
         }
 
         // Update the candidate in the global list with Minimax score and Type 1 (Red)
@@ -287,41 +995,39 @@ void GomokuAI::getBestMove(int &bestRow, int &bestCol)
             break;
     }
 
-#ifdef DEBUG_AI_LOGS
-    logMoveAnalysis(bestRow, bestCol, aiPlayer, alpha, true);
-#endif
+    // La racine n'apparaît jamais comme enfant dans l'arbre : son entrée est
+    // écrite ici pour que la PV (extractPV) et la prédiction du ponder
+    // partent de la position courante et non de ses filles.
+    int rootSym = 0;
+    uint64_t rootKey = canonicalKey(rootSym);
+    ttStore(rootKey, depth, alpha, 0,
+            symApplyIdx(rootSym, outRow * BOARD_SIZE + outCol));
+
+    return true;
 }
 
 bool GomokuAI::checkWinQuick(int row, int col, int player)
 {
+    const BitBoard &own = planes[player];
+    const BitBoard &opp = planes[getOpponent(player)];
+
     for (int dir = 0; dir < 4; dir++)
     {
-        int count = 1;
+        // 5 alignées passent forcément dans la fenêtre ±4 autour du coup.
+        uint32_t key = packWindow(own, opp, row, col, AXES[dir], 4);
 
-        int r = row + dy[dir];
-        int c = col + dx[dir];
-        while (GomokuRules::isOnBoard(r, c) && board[r][c] == player)
-        {
+        int count = 1;
+        for (int i = 5; i <= 8 && windowCell(key, i) == WIN_OWN; i++)
             count++;
-            r += dy[dir];
-            c += dx[dir];
-        }
-
-        r = row - dy[dir];
-        c = col - dx[dir];
-        while (GomokuRules::isOnBoard(r, c) && board[r][c] == player)
-        {
+        for (int i = 3; i >= 0 && windowCell(key, i) == WIN_OWN; i--)
             count++;
-            r -= dy[dir];
-            c -= dx[dir];
-        }
 
         if (count >= 5)
             return true;
     }
 
     int captures = (player == BLACK) ? gameState.capturedByBlack : gameState.capturedByWhite;
-    int potentialCaptures = GomokuRules::checkCaptures(board, row, col, player);
+    int potentialCaptures = captureCount(player, row, col);
 
     return captures + potentialCaptures >= MAX_CAPTURE_STONES;
 }
@@ -330,75 +1036,25 @@ int GomokuAI::analyzePatternScore(int row, int col, int player)
 {
     int score = 0;
 
-    for (int dir = 0; dir < 4; dir++)
-    {
-        int count = 1;
-        int openEnds = 0;
-
-        // Count right
-        int r = row + dy[dir];
-        int c = col + dx[dir];
-        while (GomokuRules::isOnBoard(r, c) && board[r][c] == player && count < 5)
-        {
-            count++;
-            r += dy[dir];
-            c += dx[dir];
-        }
-        if (GomokuRules::isEmptyCell(board, r, c))
-            openEnds++;
-
-        // Count left
-        r = row - dy[dir];
-        c = col - dx[dir];
-        while (GomokuRules::isOnBoard(r, c) && board[r][c] == player && count < 5)
-        {
-            count++;
-            r -= dy[dir];
-            c -= dx[dir];
-        }
-        if (GomokuRules::isEmptyCell(board, r, c))
-            openEnds++;
-
-        // Score pattern
-        int patternScore = 0;
-        const char *patternType = "";
-
-        switch (count)
-        {
-        case 5:
-            patternScore = SCORE_FIVE;
-            break;
-        case 4:
-
-            if (openEnds == 2)
-                patternScore = SCORE_LIVE_FOUR;
-            else
-                patternScore = SCORE_DEAD_FOUR;
-            break;
-        case 3:
-
-            if (openEnds == 2)
-                patternScore = SCORE_LIVE_THREE;
-            else
-                patternScore = SCORE_DEAD_THREE;
-            break;
-        case 2:
-
-            if (openEnds == 2)
-                patternScore = SCORE_LIVE_TWO;
-            else
-                patternScore = SCORE_DEAD_TWO;
+    const BitBoard &own = planes[player];
+    const BitBoard &opp = planes[getOpponent(player)];
 
-            break;
-        case 1:
-            patternScore = SCORE_ONE;
-            break;
+    // Barème [longueur][extrémités ouvertes], aligné sur l'ancien switch :
+    // 2 bouts libres = motif vivant, sinon motif mort.
+    static const int PATTERN_SCORE[6][3] = {
+        {0, 0, 0},
+        {SCORE_ONE, SCORE_ONE, SCORE_ONE},
+        {SCORE_DEAD_TWO, SCORE_DEAD_TWO, SCORE_LIVE_TWO},
+        {SCORE_DEAD_THREE, SCORE_DEAD_THREE, SCORE_LIVE_THREE},
+        {SCORE_DEAD_FOUR, SCORE_DEAD_FOUR, SCORE_LIVE_FOUR},
+        {SCORE_FIVE, SCORE_FIVE, SCORE_FIVE}};
 
-        default:
-            break;
-        }
+    for (int dir = 0; dir < 4; dir++)
+    {
+        uint32_t key = packWindow(own, opp, row, col, AXES[dir], PATTERN_WINDOW_SPAN);
+        uint8_t entry = patternTable[key];
 
-        score += patternScore;
+        score += PATTERN_SCORE[patternCount(entry)][patternOpenEnds(entry)];
     }
     return score;
 }
@@ -407,8 +1063,8 @@ int GomokuAI::evaluateMoveQuick(int row, int col, int player)
 {
     int opponent = getOpponent(player);
     int score = 0;
-    int potentialCaptureCount = GomokuRules::checkCaptures(board, row, col, player);
-    int potentialOppCaptureCount = GomokuRules::checkCaptures(board, row, col, getOpponent(player));
+    int potentialCaptureCount = captureCount(player, row, col);
+    int potentialOppCaptureCount = captureCount(opponent, row, col);
 
     int playerCapture = (player == BLACK) ? gameState.capturedByBlack : gameState.capturedByWhite;
     int opponentCapture = (player == BLACK) ? gameState.capturedByWhite : gameState.capturedByBlack;
@@ -440,20 +1096,127 @@ int GomokuAI::evaluateMoveQuick(int row, int col, int player)
     return score;
 }
 
-int GomokuAI::minimax(int depth, int alpha, int beta, int player)
+// Recherche de quiescence : à l'horizon, la recherche se prolonge sur les
+// seuls coups de capture jusqu'à position calme (ou épuisement du quota de
+// plis). L'évaluation statique sert de plancher (« stand pat ») : on n'est
+// jamais obligé de capturer. Évite de rendre une évaluation au milieu d'un
+// échange de captures, pour une fraction du coût d'une profondeur de plus.
+int GomokuAI::quiescence(int alpha, int beta, int player, int qdepth)
 {
+    if (++timeCheckCounter >= TIME_CHECK_INTERVAL)
+    {
+        timeCheckCounter = 0;
+        if (std::chrono::steady_clock::now() >= searchDeadline ||
+            searchCancelled.load(std::memory_order_relaxed) ||
+            (isHelper && smpStop.load(std::memory_order_relaxed)) ||
+            (searchNodeBudget > 0 && !isHelper &&
+             searchStats.nodes >= searchNodeBudget))
+            searchAborted = true;
+        if (!isHelper)
+            searchProgressBuffer[PROGRESS_NODES] =
+                (searchStats.nodes > INT_MAX) ? INT_MAX : (int)searchStats.nodes;
+    }
 
-    if (depth == 0)
-        return evaluateBoard(player);
+    if (searchAborted)
+        return 0;
 
-    if (transpositionTable.count(currentHash))
-    {
-        TTEntry &entry = transpositionTable[currentHash];
-        if (entry.depth >= depth)
-        {
-            bool usable = false;
-            if (entry.flag == 0)
-                usable = true;
+    if (!isHelper)
+        searchStats.nodes++;
+
+    int pCaps = (player == BLACK) ? gameState.capturedByBlack : gameState.capturedByWhite;
+    if (pCaps >= MAX_CAPTURE_STONES)
+        return SCORE_FIVE;
+
+    int standPat = evaluateBoard(player);
+    if (standPat >= beta)
+        return standPat;
+    if (standPat > alpha)
+        alpha = standPat;
+
+    if (qdepth == 0)
+        return standPat;
+
+    int opponent = getOpponent(player);
+    int bestScore = standPat;
+
+    // Liste du pli courant (indexée par la profondeur make/undo) : les
+    // niveaux inférieurs gardent la leur intacte
+    int ply = (undoDepth < PLY_LIST_COUNT) ? undoDepth : PLY_LIST_COUNT - 1;
+    Move *candidates = plyMoves[ply];
+    int candCount = getCandidateMoves(player, candidates);
+
+    for (int i = 0; i < candCount; i++)
+    {
+        const Move &move = candidates[i];
+
+        // Un coup qui capture est toujours légal (les interdictions suicide /
+        // double-trois ne s'appliquent qu'aux coups sans capture)
+        if (captureDirMask[player][move.row][move.col] == 0)
+            continue;
+
+        makeMoveInternal(move.row, move.col, player);
+        int score = -quiescence(-beta, -alpha, opponent, qdepth - 1);
+        undoMove();
+
+        if (score > bestScore)
+            bestScore = score;
+        if (score > alpha)
+            alpha = score;
+        if (alpha >= beta)
+            break;
+    }
+
+    return bestScore;
+}
+
+int GomokuAI::minimax(int depth, int alpha, int beta, int player, bool allowNull)
+{
+    // Vérification du budget temps, de l'annulation, du stop SMP et du
+    // budget de nœuds (enveloppe de force), amortie sur TIME_CHECK_INTERVAL
+    // nœuds ; le compteur de nœuds est republié au passage
+    if (++timeCheckCounter >= TIME_CHECK_INTERVAL)
+    {
+        timeCheckCounter = 0;
+        if (std::chrono::steady_clock::now() >= searchDeadline ||
+            searchCancelled.load(std::memory_order_relaxed) ||
+            (isHelper && smpStop.load(std::memory_order_relaxed)) ||
+            (searchNodeBudget > 0 && !isHelper &&
+             searchStats.nodes >= searchNodeBudget))
+            searchAborted = true;
+        if (!isHelper)
+            searchProgressBuffer[PROGRESS_NODES] =
+                (searchStats.nodes > INT_MAX) ? INT_MAX : (int)searchStats.nodes;
+    }
+
+    if (searchAborted)
+        return 0;
+
+    if (!isHelper)
+        searchStats.nodes++;
+
+    if (depth == 0)
+        return quiescence(alpha, beta, player, QUIESCENCE_MAX_PLY);
+
+    // En ouverture, la clé est repliée sur l'orientation canonique : les
+    // coups de la table y sont exprimés et doivent être reconvertis ici
+    TTEntry entry;
+    int ttSym = 0;
+    uint64_t ttHash = canonicalKey(ttSym);
+    bool ttHit = ttProbe(ttHash, entry);
+    if (!isHelper)
+    {
+        searchStats.ttProbes++;
+        if (ttHit)
+            searchStats.ttHits++;
+    }
+
+    if (ttHit)
+    {
+        if (entry.depth >= depth)
+        {
+            bool usable = false;
+            if (entry.flag == 0)
+                usable = true;
             else if (entry.flag == 1 && entry.score <= alpha)
                 usable = true;
             else if (entry.flag == 2 && entry.score >= beta)
@@ -472,87 +1235,852 @@ int GomokuAI::minimax(int depth, int alpha, int beta, int player)
     if (pCaps >= MAX_CAPTURE_STONES)
         return SCORE_FIVE + depth;
 
-    std::vector<Move> candidates = getCandidateMoves(player);
-    if (candidates.empty())
-        return evaluateBoard(player);
-
-    for (Move &m : candidates)
+    // --- Coup nul : on passe le trait ; si une recherche réduite en fenêtre
+    // nulle réfute quand même, le nœud coupe sans générer un seul coup. Évité
+    // dans les fenêtres de mat, sous alpha statique, et en cascade.
+    if (allowNull && depth >= NULL_MOVE_MIN_DEPTH && beta < SCORE_FIVE &&
+        evaluateBoard(player) >= beta)
     {
-        m.score = evaluateMoveQuick(m.row, m.col, player);
-        if (m.score < SCORE_LIVE_FOUR && GomokuRules::isStoneCapturable(board, m.row, m.col, getOpponent(player)))
-            m.score = INT_MIN;
-    }
+        int reduction = (depth > 6) ? 3 : 2;
 
-    std::sort(candidates.begin(), candidates.end(),
-              [](const Move &a, const Move &b)
-              { return a.score > b.score; });
+        currentHash ^= NULL_SIDE_KEY;
+        for (int s = 0; s < 7; s++)
+            symHashes[s] ^= NULL_SIDE_KEY;
 
-    candidates.resize(MAX_LEAFT_CANDIDATES);
+        int nullScore = -minimax(depth - 1 - reduction, -beta, -beta + 1,
+                                 opponent, false);
+
+        currentHash ^= NULL_SIDE_KEY;
+        for (int s = 0; s < 7; s++)
+            symHashes[s] ^= NULL_SIDE_KEY;
+
+        if (!searchAborted && nullScore >= beta)
+            return beta;
+    }
 
     int bestScore = -INT_MAX;
     int oldAlpha = alpha;
+    int bestMoveIdx = -1;
+    int searched = 0;
+    bool cutoff = false;
+
+    // --- Étape 1 : coup TT puis killers, essayés avant toute évaluation ---
 
-    for (const Move &move : candidates)
+    int ttMoveIdx = ttHit ? symApplyIdx(SYM_INVERSE[ttSym], entry.bestMove) : -1;
+    int priorityMoves[3] = {ttMoveIdx, killerMoves[depth][0], killerMoves[depth][1]};
+    int tried[3];
+    int triedCount = 0;
+
+    for (int pm = 0; pm < 3 && !cutoff; pm++)
     {
-        makeMoveInternal(move.row, move.col, player);
+        int idx = priorityMoves[pm];
+        if (idx < 0)
+            continue;
+        if ((pm >= 1 && idx == priorityMoves[0]) || (pm == 2 && idx == priorityMoves[1]))
+            continue;
+
+        int r = idx / BOARD_SIZE;
+        int c = idx % BOARD_SIZE;
+        if (!candidateMask.test(r, c) || board[r][c] != NONE)
+            continue;
+        if (GomokuRules::validateMove(board, r, c, player) != VALID)
+            continue;
+
+        tried[triedCount++] = idx;
+        searched++;
+
+        makeMoveInternal(r, c, player);
         int score = -minimax(depth - 1, -beta, -alpha, opponent);
         undoMove();
 
         if (score > bestScore)
+        {
             bestScore = score;
-
+            bestMoveIdx = idx;
+        }
         if (score > alpha)
             alpha = score;
-
         if (alpha >= beta)
-            break;
+        {
+            recordCutoff(depth, player, idx);
+            cutoff = true;
+        }
     }
 
-    TTEntry entry;
-    entry.score = bestScore;
-    entry.depth = depth;
-    entry.flag = (bestScore <= oldAlpha) ? 1 : (bestScore >= beta ? 2 : 0);
-    transpositionTable[currentHash] = entry;
+    // --- Étape 2 : le reste, trié heuristique + historique ---
+
+    if (!cutoff)
+    {
+        int ply = (undoDepth < PLY_LIST_COUNT) ? undoDepth : PLY_LIST_COUNT - 1;
+        Move *candidates = plyMoves[ply];
+        int candCount = getCandidateMoves(player, candidates);
+
+        if (candCount == 0 && searched == 0)
+            return evaluateBoard(player);
+
+        for (int i = 0; i < candCount; i++)
+        {
+            Move &m = candidates[i];
+            m.score = evaluateMoveQuick(m.row, m.col, player);
+            if (m.score < SCORE_LIVE_FOUR && GomokuRules::isStoneCapturable(board, m.row, m.col, getOpponent(player)))
+                m.score = INT_MIN;
+            else
+                m.score += historyTable[player][m.row][m.col];
+        }
+
+        std::sort(candidates, candidates + candCount,
+                  [](const Move &a, const Move &b)
+                  { return a.score > b.score; });
+
+        // --- Futilité au nœud frontière : l'évaluation statique est si loin
+        // sous alpha qu'aucun coup calme ne peut la remonter ; seuls les
+        // coups tactiques (menace forte ou capture) restent explorés.
+        bool futile = (depth == 1 &&
+                       evaluateBoard(player) + FUTILITY_MARGIN <= alpha);
+
+        for (int i = 0; i < candCount; i++)
+        {
+            const Move &move = candidates[i];
+
+            if (searched >= leafCandidateLimit)
+                break;
+
+            int idx = move.row * BOARD_SIZE + move.col;
+            bool alreadyTried = false;
+            for (int t = 0; t < triedCount; t++)
+                if (tried[t] == idx)
+                    alreadyTried = true;
+            if (alreadyTried)
+                continue;
+
+            if (futile && searched > 0 && move.score < SCORE_LIVE_THREE &&
+                captureDirMask[player][move.row][move.col] == 0)
+                continue;
+
+            // Légalité différée : seuls les coups qui survivent au tri paient
+            // le validateMove complet (suicide, double-trois)
+            if (GomokuRules::validateMove(board, move.row, move.col, player) != VALID)
+                continue;
+
+            searched++;
+
+            makeMoveInternal(move.row, move.col, player);
+
+            // --- Réduction des coups tardifs : les coups mal classés par le
+            // tri sont sondés à profondeur réduite en fenêtre nulle ; une
+            // surprise au-dessus d'alpha paie la recherche complète.
+            int score;
+            bool reduce = (depth >= LMR_MIN_DEPTH &&
+                           searched > LMR_FIRST_REDUCED &&
+                           move.score < SCORE_LIVE_FOUR &&
+                           undoStack[undoDepth - 1].captureCount == 0);
+            if (reduce)
+            {
+                score = -minimax(depth - 2, -alpha - 1, -alpha, opponent);
+                if (score > alpha && !searchAborted)
+                    score = -minimax(depth - 1, -beta, -alpha, opponent);
+            }
+            else
+            {
+                score = -minimax(depth - 1, -beta, -alpha, opponent);
+            }
+            undoMove();
+
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestMoveIdx = idx;
+            }
+
+            if (score > alpha)
+                alpha = score;
+
+            if (alpha >= beta)
+            {
+                recordCutoff(depth, player, idx);
+                break;
+            }
+        }
+    }
+
+    if (searched == 0)
+        return evaluateBoard(player);
+
+    // Un score issu d'un sous-arbre interrompu ne doit pas polluer la table
+    if (searchAborted)
+        return 0;
+
+    ttStore(ttHash, depth, bestScore,
+            (bestScore <= oldAlpha) ? 1 : (bestScore >= beta ? 2 : 0),
+            symApplyIdx(ttSym, bestMoveIdx));
 
     return bestScore;
 }
 
-std::vector<Move> GomokuAI::getCandidateMoves(int player)
+// =================================================================================
+//                  RECHERCHE DANS L'ESPACE DES MENACES (VCF)
+// =================================================================================
+//
+// Les victoires forcées par enchaînement de quatre échappent à minimax : à
+// MAX_LEAFT_CANDIDATES = 8 coups par nœud, une combinaison de 15 plis est
+// hors de portée du budget. Ici, l'attaquant ne joue que des coups forçants —
+// un coup qui gagne sur-le-champ (cinq ou dixième pierre capturée, via
+// checkWinQuick) ou qui laisse une case de complétion en cinq — et seules les
+// réponses du défenseur qui parent réellement la menace sont développées :
+// les autres perdent au coup suivant, sans récursion. L'arbre qui en résulte
+// est assez étroit pour être fouillé à THREAT_MAX_PLIES avant la recherche
+// générale.
+//
+// Le verdict « gagné » repose sur checkWinQuick, comme le balayage rapide de
+// la racine : même approximation, déjà acceptée par le moteur, d'une cinq
+// supposée imprenable. Un VCF qui échoue ou expire rend simplement la main à
+// la recherche générale.
+
+// Cases vides où `player` complèterait un alignement de cinq passant par la
+// fenêtre de (row, col), la pierre de (row, col) étant déjà posée. Écrit au
+// plus 16 complétions (row * BOARD_SIZE + col) et retourne leur nombre :
+// zéro signifie que le coup n'était pas forçant.
+int GomokuAI::fiveCompletions(int row, int col, int player, int *out)
 {
-    std::vector<Move> candidates;
-    candidates.reserve(CANDIDATES_SIZE);
+    const BitBoard &own = planes[player];
+    const BitBoard &opp = planes[getOpponent(player)];
 
-    bool visited[BOARD_SIZE][BOARD_SIZE] = {false};
-    const int RADIUS = 2;
+    int count = 0;
 
-    for (int r = 0; r < BOARD_SIZE; r++)
+    for (int dir = 0; dir < 4; dir++)
     {
-        for (int c = 0; c < BOARD_SIZE; c++)
+        // Une cinq contenant (row, col) et sa case de complétion tient dans
+        // la fenêtre ±4 (même argument que checkWinQuick).
+        uint32_t key = packWindow(own, opp, row, col, AXES[dir], 4);
+
+        for (int i = 0; i < 9 && count < 16; i++)
         {
-            if (board[r][c] != NONE)
+            if (windowCell(key, i) != WIN_EMPTY)
+                continue;
+
+            // Longueur du bloc contigu si l'attaquant jouait la case i
+            int run = 1;
+            for (int j = i + 1; j <= 8 && windowCell(key, j) == WIN_OWN; j++)
+                run++;
+            for (int j = i - 1; j >= 0 && windowCell(key, j) == WIN_OWN; j--)
+                run++;
+
+            if (run < 5)
+                continue;
+
+            int r = row + AXES[dir].r * (i - 4);
+            int c = col + AXES[dir].c * (i - 4);
+            out[count++] = r * BOARD_SIZE + c;
+        }
+    }
+
+    return count;
+}
+
+// Vrai si l'attaquant dispose d'une victoire forcée à `depth` plis. Le coup
+// qui l'amorce est laissé dans threatRow/threatCol : les niveaux profonds
+// écrivent d'abord, la racine écrase en dernier pendant le dépilement.
+bool GomokuAI::threatWin(int depth, int attacker)
+{
+    if (threatAborted)
+        return false;
+
+    if (depth <= 0)
+    {
+        // Ligne non résolue faute d'horizon : l'itération suivante, plus
+        // profonde, peut encore la transformer en victoire
+        threatDepthLimited = true;
+        return false;
+    }
+
+    if (++threatCheckCounter >= THREAT_CHECK_INTERVAL)
+    {
+        threatCheckCounter = 0;
+        if (std::chrono::steady_clock::now() >= threatDeadline ||
+            (!isHelper && searchCancelled.load(std::memory_order_relaxed)))
+        {
+            threatAborted = true;
+            return false;
+        }
+    }
+
+    int defender = getOpponent(attacker);
+
+    int ply = (undoDepth < PLY_LIST_COUNT) ? undoDepth : PLY_LIST_COUNT - 1;
+    Move *candidates = plyMoves[ply];
+    int candCount = getCandidateMoves(attacker, candidates);
+
+    for (int idx = 0; idx < candCount; idx++)
+    {
+        int r = candidates[idx].row;
+        int c = candidates[idx].col;
+
+        // Filtre forçant avant la validation complète : pose provisoire de
+        // la pierre seule (sans captures), suffisante pour checkWinQuick et
+        // la détection de complétion.
+        board[r][c] = attacker;
+        planes[attacker].set(r, c);
+        bool immediate = checkWinQuick(r, c, attacker);
+        int probe[16];
+        bool forcing = immediate || fiveCompletions(r, c, attacker, probe) > 0;
+        planes[attacker].reset(r, c);
+        board[r][c] = NONE;
+
+        if (!forcing)
+            continue;
+        if (GomokuRules::validateMove(board, r, c, attacker) != VALID)
+            continue;
+
+        if (immediate)
+        {
+            threatRow = r;
+            threatCol = c;
+            return true;
+        }
+
+        makeMoveInternal(r, c, attacker);
+
+        // Les complétions sont recalculées après le coup réel : une capture
+        // déclenchée par la pose peut avoir modifié la ligne.
+        int comps[16];
+        int compCount = fiveCompletions(r, c, attacker, comps);
+
+        bool refuted = (compCount == 0); // la menace n'a pas survécu au coup
+        bool anyDefense = false;
+
+        if (!refuted)
+        {
+            int dply = (undoDepth < PLY_LIST_COUNT) ? undoDepth : PLY_LIST_COUNT - 1;
+            Move *replies = plyMoves[dply];
+            int replyCount = getCandidateMoves(defender, replies);
+
+            for (int d = 0; d < replyCount && !refuted; d++)
             {
-                for (int dr = -RADIUS; dr <= RADIUS; dr++)
-                {
-                    for (int dc = -RADIUS; dc <= RADIUS; dc++)
-                    {
-                        int nr = r + dr;
-                        int nc = c + dc;
+                int dr = replies[d].row;
+                int dc = replies[d].col;
 
-                        if (!GomokuRules::isEmptyCell(board, nr, nc) && visited[nr][nc])
-                            continue;
+                if (GomokuRules::validateMove(board, dr, dc, defender) != VALID)
+                    continue;
+
+                makeMoveInternal(dr, dc, defender);
+                anyDefense = true;
 
-                        if (GomokuRules::validateMove(board, nr, nc, player) != VALID)
+                bool survives;
+                if (checkWinQuick(dr, dc, defender))
+                {
+                    // Contre-attaque gagnante du défenseur : ligne réfutée
+                    survives = false;
+                }
+                else
+                {
+                    // La réponse a-t-elle paré la cinq immédiate ? Sinon,
+                    // l'attaquant conclut au coup suivant, sans récursion.
+                    bool stillWins = false;
+                    for (int k = 0; k < compCount && !stillWins; k++)
+                    {
+                        int xr = comps[k] / BOARD_SIZE;
+                        int xc = comps[k] % BOARD_SIZE;
+                        if (board[xr][xc] != NONE)
                             continue;
 
-                        candidates.push_back(Move(nr, nc, 0));
-                        visited[nr][nc] = true;
+                        board[xr][xc] = attacker;
+                        planes[attacker].set(xr, xc);
+                        stillWins = checkWinQuick(xr, xc, attacker);
+                        planes[attacker].reset(xr, xc);
+                        board[xr][xc] = NONE;
                     }
+
+                    survives = stillWins || threatWin(depth - 2, attacker);
                 }
+
+                undoMove();
+
+                if (!survives)
+                    refuted = true;
             }
+
+            // Défenseur sans réponse légale : pat, pas une victoire
+            if (!anyDefense)
+                refuted = true;
+        }
+
+        undoMove();
+
+        if (!refuted && !threatAborted)
+        {
+            threatRow = r;
+            threatCol = c;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Point d'entrée : cherche une victoire forcée depuis la position courante
+// pour aiPlayer, dans une tranche du budget. Retourne le premier coup de la
+// combinaison trouvée.
+bool GomokuAI::threatSpaceSearch(int budgetMs, int &outRow, int &outCol)
+{
+    int slice = budgetMs / THREAT_BUDGET_DIVISOR;
+    if (slice <= 0)
+        slice = 1;
+
+    threatDeadline = std::chrono::steady_clock::now() +
+                     std::chrono::milliseconds(slice);
+    threatAborted = false;
+    threatCheckCounter = 0;
+
+    // Approfondissement itératif sur la profondeur de menace : les
+    // combinaisons courtes sont trouvées d'abord (et en premier lieu la plus
+    // courte), et un horizon profond n'est payé que si les horizons courts
+    // ont déjà échoué dans le budget.
+    for (int plies = 2; plies <= THREAT_MAX_PLIES && !threatAborted; plies += 2)
+    {
+        threatRow = threatCol = -1;
+        threatDepthLimited = false;
+
+        if (threatWin(plies, aiPlayer) && threatRow >= 0)
+        {
+            outRow = threatRow;
+            outCol = threatCol;
+            return true;
+        }
+
+        // Aucune ligne n'a buté sur l'horizon : approfondir ne changerait
+        // rien, la position n'a pas de victoire forcée par coups forçants
+        if (!threatDepthLimited)
+            break;
+    }
+
+    return false;
+}
+
+// =================================================================================
+//                      SOLVEUR DE COURSE AUX CAPTURES
+// =================================================================================
+//
+// À RACE_TRIGGER_STONES captures, la position est une course pure : chaque
+// paire prise rapproche de MAX_CAPTURE_STONES et l'évaluation plate
+// (pCaps * barème) ne voit pas les séquences forcées. Le solveur restreint
+// l'attaquant aux coups qui capturent (index de capture déjà armé) et
+// développe toutes les parades du défenseur, comme le VCF. Les transpositions
+// — fréquentes quand plusieurs paires sont prenables dans un ordre libre —
+// sont mémoïsées dans une table dédiée, car le hash Zobrist du moteur
+// n'encode ni les compteurs de capture ni le trait.
+
+struct RaceEntry
+{
+    uint64_t key;
+    int16_t depth;    // horizon auquel le résultat a été établi
+    int8_t result;    // +1 victoire prouvée, -1 non prouvée à cet horizon
+    uint16_t moveIdx; // coup gagnant (row * BOARD_SIZE + col) si result > 0
+};
+
+static RaceEntry raceTable[1 << RACE_TABLE_BITS];
+
+// Clé de mémoïsation : position + compteurs de capture + attaquant
+static inline uint64_t raceKey(uint64_t hash, int capB, int capW, int attacker)
+{
+    uint64_t k = hash;
+    k ^= (uint64_t)(capB + 1) * 0x9E3779B97F4A7C15ULL;
+    k ^= (uint64_t)(capW + 1) * 0xC2B2AE3D27D4EB4FULL;
+    if (attacker == BLACK)
+        k ^= 0xD6E8FEB86659FD93ULL;
+    return k;
+}
+
+// Vrai si l'attaquant force la victoire à `depth` plis en ne jouant que des
+// captures. Même convention que threatWin : le coup initial est laissé dans
+// raceRow/raceCol, la racine écrase en dernier pendant le dépilement.
+bool GomokuAI::raceWin(int depth, int attacker)
+{
+    if (threatAborted)
+        return false;
+
+    if (depth <= 0)
+    {
+        raceDepthLimited = true;
+        return false;
+    }
+
+    if (++threatCheckCounter >= THREAT_CHECK_INTERVAL)
+    {
+        threatCheckCounter = 0;
+        if (std::chrono::steady_clock::now() >= threatDeadline ||
+            (!isHelper && searchCancelled.load(std::memory_order_relaxed)))
+        {
+            threatAborted = true;
+            return false;
+        }
+    }
+
+    uint64_t key = raceKey(currentHash, gameState.capturedByBlack,
+                           gameState.capturedByWhite, attacker);
+    RaceEntry &entry = raceTable[key & ((1 << RACE_TABLE_BITS) - 1)];
+    if (entry.key == key)
+    {
+        if (entry.result > 0)
+        {
+            raceRow = entry.moveIdx / BOARD_SIZE;
+            raceCol = entry.moveIdx % BOARD_SIZE;
+            return true;
+        }
+        // Réfutation valable seulement si établie à un horizon au moins égal
+        if (entry.depth >= depth)
+            return false;
+    }
+
+    int defender = getOpponent(attacker);
+
+    int ply = (undoDepth < PLY_LIST_COUNT) ? undoDepth : PLY_LIST_COUNT - 1;
+    Move *candidates = plyMoves[ply];
+    int candCount = getCandidateMoves(attacker, candidates);
+
+    for (int idx = 0; idx < candCount; idx++)
+    {
+        int r = candidates[idx].row;
+        int c = candidates[idx].col;
+
+        // Seuls les coups qui capturent font avancer la course
+        if (captureDirMask[attacker][r][c] == 0)
+            continue;
+        if (GomokuRules::validateMove(board, r, c, attacker) != VALID)
+            continue;
+
+        // Victoire immédiate (dixième pierre ou cinq) : pose provisoire,
+        // l'index de capture de la case n'est pas affecté par sa propre pierre
+        board[r][c] = attacker;
+        planes[attacker].set(r, c);
+        bool immediate = checkWinQuick(r, c, attacker);
+        planes[attacker].reset(r, c);
+        board[r][c] = NONE;
+
+        if (immediate)
+        {
+            raceRow = r;
+            raceCol = c;
+            entry = {key, (int16_t)depth, 1, (uint16_t)(r * BOARD_SIZE + c)};
+            return true;
+        }
+
+        makeMoveInternal(r, c, attacker);
+
+        bool refuted = false;
+        bool anyDefense = false;
+
+        int dply = (undoDepth < PLY_LIST_COUNT) ? undoDepth : PLY_LIST_COUNT - 1;
+        Move *replies = plyMoves[dply];
+        int replyCount = getCandidateMoves(defender, replies);
+
+        for (int d = 0; d < replyCount && !refuted; d++)
+        {
+            int dr = replies[d].row;
+            int dc = replies[d].col;
+
+            if (GomokuRules::validateMove(board, dr, dc, defender) != VALID)
+                continue;
+
+            makeMoveInternal(dr, dc, defender);
+            anyDefense = true;
+
+            // Contre-attaque gagnante du défenseur (sa dixième pierre ou une
+            // cinq) : la ligne est réfutée ; sinon l'attaquant doit pouvoir
+            // relancer la course quelle que soit la parade
+            bool survives = !checkWinQuick(dr, dc, defender) &&
+                            raceWin(depth - 2, attacker);
+
+            undoMove();
+
+            if (!survives)
+                refuted = true;
+        }
+
+        // Défenseur sans réponse légale : pat, pas une victoire
+        if (!anyDefense)
+            refuted = true;
+
+        undoMove();
+
+        if (!refuted && !threatAborted)
+        {
+            raceRow = r;
+            raceCol = c;
+            entry = {key, (int16_t)depth, 1, (uint16_t)(r * BOARD_SIZE + c)};
+            return true;
         }
     }
 
-    return candidates;
+    if (!threatAborted)
+        entry = {key, (int16_t)depth, -1, 0};
+
+    return false;
+}
+
+// Point d'entrée : résout la course aux captures pour aiPlayer dans une
+// petite tranche du budget. Retourne le premier coup de la séquence gagnante.
+bool GomokuAI::captureRaceSearch(int budgetMs, int &outRow, int &outCol)
+{
+    int slice = budgetMs / RACE_BUDGET_DIVISOR;
+    if (slice <= 0)
+        slice = 1;
+
+    threatDeadline = std::chrono::steady_clock::now() +
+                     std::chrono::milliseconds(slice);
+    threatAborted = false;
+    threatCheckCounter = 0;
+
+    // Même approfondissement itératif que le VCF : la séquence la plus
+    // courte d'abord, les horizons longs seulement si nécessaire
+    for (int plies = 2; plies <= RACE_MAX_PLIES && !threatAborted; plies += 2)
+    {
+        raceRow = raceCol = -1;
+        raceDepthLimited = false;
+
+        if (raceWin(plies, aiPlayer) && raceRow >= 0)
+        {
+            outRow = raceRow;
+            outCol = raceCol;
+            return true;
+        }
+
+        if (!raceDepthLimited)
+            break;
+    }
+
+    return false;
+}
+
+void GomokuAI::addNeighborSeeds(int row, int col, int delta)
+{
+    const int RADIUS = 2;
+
+    for (int dr = -RADIUS; dr <= RADIUS; dr++)
+    {
+        for (int dc = -RADIUS; dc <= RADIUS; dc++)
+        {
+            int nr = row + dr;
+            int nc = col + dc;
+
+            if (!GomokuRules::isOnBoard(nr, nc))
+                continue;
+
+            neighborCount[nr][nc] += delta;
+            if (neighborCount[nr][nc] > 0)
+                candidateMask.set(nr, nc);
+            else
+                candidateMask.reset(nr, nc);
+        }
+    }
+}
+
+void GomokuAI::rebuildNeighborCounts()
+{
+    memset(neighborCount, 0, sizeof(neighborCount));
+    candidateMask.clear();
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+        for (int c = 0; c < BOARD_SIZE; c++)
+            if (board[r][c] != NONE)
+                addNeighborSeeds(r, c, 1);
+}
+
+// =================================================================================
+//                      INDEX DE CAPTURE INCRÉMENTAL
+// =================================================================================
+//
+// L'ancienne sonde (GomokuRules::checkCaptures sur les plans) refaisait le
+// parcours 8 directions × 3 cases à chaque appel — plusieurs fois par
+// candidat et par nœud. Le motif X,adv,adv,propre ne dépendant pas du
+// contenu de X, le masque est entretenu pour toutes les cases : une pose ou
+// un retrait en (row, col) n'invalide que les cases d'où un motif passe par
+// (row, col), soit 3 cases par direction plus la case elle-même.
+
+void GomokuAI::refreshCaptureIndexCell(int row, int col)
+{
+    for (int p = BLACK; p <= WHITE; p++)
+    {
+        int opponent = (p == BLACK) ? WHITE : BLACK;
+        uint8_t mask = 0;
+
+        for (int d = 0; d < 8; d++)
+        {
+            int dr = CAPTURE_DIRECTIONS[d].r;
+            int dc = CAPTURE_DIRECTIONS[d].c;
+
+            int r3 = row + 3 * dr;
+            int c3 = col + 3 * dc;
+            if (!GomokuRules::isOnBoard(r3, c3))
+                continue;
+
+            if (board[row + dr][col + dc] == opponent &&
+                board[row + 2 * dr][col + 2 * dc] == opponent &&
+                board[r3][c3] == p)
+                mask |= (uint8_t)(1 << d);
+        }
+
+        captureDirMask[p][row][col] = mask;
+    }
+}
+
+// Recalcule le seul bit `d` (les deux couleurs) de la case (row, col)
+void GomokuAI::refreshCaptureBit(int row, int col, int d)
+{
+    int dr = CAPTURE_DIRECTIONS[d].r;
+    int dc = CAPTURE_DIRECTIONS[d].c;
+    uint8_t bit = (uint8_t)(1 << d);
+
+    uint8_t blackBit = 0, whiteBit = 0;
+
+    int r3 = row + 3 * dr;
+    int c3 = col + 3 * dc;
+    if (GomokuRules::isOnBoard(r3, c3))
+    {
+        int pair = board[row + dr][col + dc];
+        if (pair != NONE && pair == board[row + 2 * dr][col + 2 * dc])
+        {
+            int own = board[r3][c3];
+            if (own != NONE && own != pair)
+            {
+                if (own == BLACK)
+                    blackBit = bit;
+                else
+                    whiteBit = bit;
+            }
+        }
+    }
+
+    captureDirMask[BLACK][row][col] =
+        (uint8_t)((captureDirMask[BLACK][row][col] & ~bit) | blackBit);
+    captureDirMask[WHITE][row][col] =
+        (uint8_t)((captureDirMask[WHITE][row][col] & ~bit) | whiteBit);
+}
+
+// Une case modifiée en (row, col) n'altère, pour chaque direction d, que le
+// bit d des trois cases situées en amont le long de d : le masque de la case
+// elle-même ne dépend pas de son propre contenu et n'est jamais à refaire.
+void GomokuAI::refreshCaptureIndexAround(int row, int col)
+{
+    // En freestyle l'index reste vide (voir rebuildCaptureIndex) : le moteur
+    // ne joue jamais de capture et captureCount rend zéro partout
+    if (GomokuRules::getVariant() == VARIANT_FREESTYLE)
+        return;
+
+    for (int d = 0; d < 8; d++)
+        for (int k = 1; k <= 3; k++)
+        {
+            int r = row - k * CAPTURE_DIRECTIONS[d].r;
+            int c = col - k * CAPTURE_DIRECTIONS[d].c;
+            if (GomokuRules::isOnBoard(r, c))
+                refreshCaptureBit(r, c, d);
+        }
+}
+
+void GomokuAI::rebuildCaptureIndex()
+{
+    // Variante sans captures : l'index est laissé entièrement à zéro, ce qui
+    // neutralise d'un coup l'exécution de captures (makeMoveInternal), la
+    // quiescence et les bonus de capture de l'évaluation
+    if (GomokuRules::getVariant() == VARIANT_FREESTYLE)
+    {
+        memset(captureDirMask, 0, sizeof(captureDirMask));
+        return;
+    }
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+        for (int c = 0; c < BOARD_SIZE; c++)
+            refreshCaptureIndexCell(r, c);
+}
+
+// Itère le masque de voisinage (cases vides uniquement), dans le même ordre
+// ligne par ligne qu'avant, et remplit le tableau fourni par l'appelant
+// (liste de pli ou buffer racine — jamais d'allocation). La légalité
+// (suicide, double-trois) n'est PAS vérifiée ici : elle est payée par
+// l'appelant, uniquement pour les coups retenus après le tri.
+int GomokuAI::getCandidateMoves(int player, Move *out)
+{
+    (void)player;
+
+    int count = 0;
+
+    for (int w = 0; w < BB_WORDS; w++)
+    {
+        uint64_t bits = candidateMask.bits[w] &
+                        ~(planes[BLACK].bits[w] | planes[WHITE].bits[w]);
+        while (bits)
+        {
+            int idx = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            out[count++] = Move(idx / BOARD_SIZE, idx % BOARD_SIZE, 0);
+        }
+    }
+
+    return count;
+}
+
+// =================================================================================
+//                          ÉVALUATION INCRÉMENTALE
+// =================================================================================
+
+void GomokuAI::rebuildEvaluation()
+{
+    evalSum[BLACK] = 0;
+    evalSum[WHITE] = 0;
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+        for (int c = 0; c < BOARD_SIZE; c++)
+        {
+            cellContribColor[r][c] = NONE;
+            if (board[r][c] != NONE)
+            {
+                int v = evaluateMoveQuick(r, c, board[r][c]);
+                cellContribution[r][c] = v;
+                cellContribColor[r][c] = board[r][c];
+                evalSum[board[r][c]] += v;
+            }
+        }
+
+    evalDirty = false;
+}
+
+void GomokuAI::refreshEvalCell(int row, int col)
+{
+    if (cellContribColor[row][col] != NONE)
+    {
+        evalSum[cellContribColor[row][col]] -= cellContribution[row][col];
+        cellContribColor[row][col] = NONE;
+    }
+
+    if (board[row][col] != NONE)
+    {
+        int v = evaluateMoveQuick(row, col, board[row][col]);
+        cellContribution[row][col] = v;
+        cellContribColor[row][col] = board[row][col];
+        evalSum[board[row][col]] += v;
+    }
+}
+
+// Une pierre qui apparaît/disparaît en (row, col) ne peut changer que la
+// contribution des pierres à distance ≤ 5 sur les 4 axes qui la traversent
+// (portée de la fenêtre de motifs), plus la case elle-même.
+void GomokuAI::refreshEvalAround(int row, int col)
+{
+    refreshEvalCell(row, col);
+
+    for (int dir = 0; dir < 4; dir++)
+    {
+        for (int off = -5; off <= 5; off++)
+        {
+            if (off == 0)
+                continue;
+
+            int r = row + off * AXES[dir].r;
+            int c = col + off * AXES[dir].c;
+            if (GomokuRules::isOnBoard(r, c) && board[r][c] != NONE)
+                refreshEvalCell(r, c);
+        }
+    }
 }
 
 int GomokuAI::evaluateBoard(int player)
@@ -567,100 +2095,506 @@ int GomokuAI::evaluateBoard(int player)
     if (oCaps >= MAX_CAPTURE_STONES)
         return -SCORE_FIVE;
 
-    int score = 0;
-    int scoreAttack = 0;
-    int scoreDefense = 0;
+    if (evaluationMode == EVAL_PLAYOUT)
+        return evaluatePlayouts(player);
+
+    if (evalDirty)
+        rebuildEvaluation();
+
+    long long score = 0;
 
     score += pCaps * SCORE_DEAD_FOUR * CAPTURE_PRIORITY_MULTIPLIER;
     score -= oCaps * SCORE_DEAD_FOUR * CAPTURE_PRIORITY_MULTIPLIER;
 
-    for (int r = 0; r < BOARD_SIZE; r++)
+    score += evalSum[player];
+    score += -evalSum[opponent] * DEFENSE_MULTIPLIER;
+
+    if (score > SCORE_FIVE)
+        return SCORE_FIVE;
+    if (score < -SCORE_FIVE)
+        return -SCORE_FIVE;
+
+    return (int)score;
+}
+
+// =================================================================================
+//                  ÉVALUATION PAR PARTIES ALÉATOIRES (PLAYOUTS)
+// =================================================================================
+//
+// Second dos d'évaluation, sélectionnable par setEvalMode côté pont : au lieu
+// du barème statique, PLAYOUT_COUNT parties aléatoires courtes jouées sur la
+// mécanique make/undo elle-même (plans de bits, captures comprises), verdict
+// rendu coup par coup par checkWinQuick. La légalité y est réduite à
+// l'occupation — checkDoubleThree et le test de suicide sont volontairement
+// ignorés, leurs violations étant un bruit négligeable sur 200 parties — et
+// les coups sont tirés dans le voisinage vivant (candidateMask). La boucle
+// n'alloue rien et travaille sur l'état déjà en cache ; chaque auxiliaire SMP
+// a son propre générateur et sa propre liste scratch.
+int GomokuAI::evaluatePlayouts(int player)
+{
+    int balance = 0; // victoires moins défaites, du point de vue de `player`
+
+    for (int g = 0; g < PLAYOUT_COUNT; g++)
     {
-        for (int c = 0; c < BOARD_SIZE; c++)
+        int toMove = player;
+        int made = 0;
+
+        for (int plyIdx = 0; plyIdx < PLAYOUT_MAX_PLIES &&
+                             undoDepth < MAX_SEARCH_PLY - 1;
+             plyIdx++)
         {
-            if (board[r][c] == player)
-            {
-                scoreAttack += evaluateMoveQuick(r, c, player);
-            }
-            else if (board[r][c] == opponent)
+            int count = getCandidateMoves(toMove, playoutMoves);
+            if (count == 0)
+                break; // pat : partie nulle
+
+            const Move &m = playoutMoves[playoutRng() % count];
+            makeMoveInternal(m.row, m.col, toMove);
+            made++;
+
+            if (checkWinQuick(m.row, m.col, toMove))
             {
-                scoreDefense -= evaluateMoveQuick(r, c, opponent);
+                balance += (toMove == player) ? 1 : -1;
+                break;
             }
+
+            toMove = getOpponent(toMove);
         }
+
+        while (made-- > 0)
+            undoMove();
+    }
+
+    return (int)((long long)balance * PLAYOUT_SCORE_SCALE / PLAYOUT_COUNT);
+}
+
+void GomokuAI::recordCutoff(int depth, int player, int moveIdx)
+{
+    if (!isHelper)
+        searchStats.cutoffs++;
+
+    if (depth >= 0 && depth < 32 && killerMoves[depth][0] != moveIdx)
+    {
+        killerMoves[depth][1] = killerMoves[depth][0];
+        killerMoves[depth][0] = moveIdx;
     }
 
-    score += scoreAttack;
-    score += scoreDefense * DEFENSE_MULTIPLIER;
+    // Plafonné pour départager les coups proches sans écraser le signal
+    // heuristique des motifs
+    int &h = historyTable[player][moveIdx / BOARD_SIZE][moveIdx % BOARD_SIZE];
+    h += depth * depth;
+    if (h > SCORE_DEAD_TWO)
+        h = SCORE_DEAD_TWO;
+}
 
-    return score;
+int GomokuAI::extractPV(int *out, int maxLen)
+{
+    int length = 0;
+    int side = aiPlayer;
+
+    // Suivi des meilleurs coups de la table depuis la position courante ; la
+    // ligne s'arrête à la première entrée absente, écrasée ou illégale.
+    while (length < maxLen)
+    {
+        TTEntry entry;
+        int sym = 0;
+        if (!ttProbe(canonicalKey(sym), entry) || entry.bestMove < 0 ||
+            entry.bestMove >= BOARD_SIZE * BOARD_SIZE)
+            break;
+
+        int moveIdx = symApplyIdx(SYM_INVERSE[sym], entry.bestMove);
+        int r = moveIdx / BOARD_SIZE;
+        int c = moveIdx % BOARD_SIZE;
+        if (board[r][c] != NONE || undoDepth >= MAX_SEARCH_PLY)
+            break;
+
+        makeMoveInternal(r, c, side);
+        out[length++] = moveIdx;
+        side = getOpponent(side);
+    }
+
+    for (int i = 0; i < length; i++)
+        undoMove();
+
+    return length;
+}
+
+long long GomokuAI::perft(int depth, int player)
+{
+    if (depth == 0)
+        return 1;
+
+    int ply = (undoDepth < PLY_LIST_COUNT) ? undoDepth : PLY_LIST_COUNT - 1;
+    Move *candidates = plyMoves[ply];
+    int candCount = getCandidateMoves(player, candidates);
+    long long total = 0;
+
+    for (int i = 0; i < candCount; i++)
+    {
+        const Move &move = candidates[i];
+
+        if (GomokuRules::validateMove(board, move.row, move.col, player) != VALID)
+            continue;
+
+        makeMoveInternal(move.row, move.col, player);
+        total += perft(depth - 1, getOpponent(player));
+        undoMove();
+    }
+
+    return total;
+}
+
+// Bascule une case de l'état `from` à `to` dans currentHash et dans ses
+// 7 images symétriques (une case transformée par orientation) : la clé
+// canonique d'ouverture reste disponible à tout moment sans rehachage.
+inline void GomokuAI::hashToggle(int row, int col, int from, int to)
+{
+    currentHash ^= zobristTable[row][col][from] ^ zobristTable[row][col][to];
+
+    const int n = BOARD_SIZE - 1;
+    const int sr[7] = {col, n - row, n - col, row, n - row, col, n - col};
+    const int sc[7] = {n - row, n - col, row, n - col, col, row, n - row};
+
+    for (int s = 0; s < 7; s++)
+        symHashes[s] ^= zobristTable[sr[s]][sc[s]][from] ^
+                        zobristTable[sr[s]][sc[s]][to];
+}
+
+uint64_t GomokuAI::canonicalKey(int &sym) const
+{
+    sym = 0;
+    if (stoneCount > CANONICAL_MAX_STONES)
+        return currentHash;
+
+    uint64_t best = currentHash;
+    for (int s = 0; s < 7; s++)
+    {
+        if (symHashes[s] < best)
+        {
+            best = symHashes[s];
+            sym = s + 1;
+        }
+    }
+    return best;
 }
 
 void GomokuAI::makeMoveInternal(int row, int col, int player)
 {
-    currentHash ^= zobristTable[row][col][NONE];
-    currentHash ^= zobristTable[row][col][player];
+    hashToggle(row, col, NONE, player);
+    stoneCount++;
 
-    MoveRecord record(Move(row, col), player);
-    stateHistory.push_back(gameState);
+    // Enregistrement d'annulation pris dans la pile fixe : aucune allocation
+    // sur le chemin make/undo (la profondeur est bornée par la recherche)
+    MoveRecord &record = undoStack[undoDepth++];
+    record.move = Move(row, col);
+    record.player = player;
+    record.captureCount = 0;
+    record.state = gameState;
+
+    // Directions de capture armées, lues dans l'index avant toute mutation
+    // (le motif n'inclut pas la case jouée, les directions sont disjointes)
+    uint8_t capMask = captureDirMask[player][row][col];
 
     board[row][col] = player;
+    planes[player].set(row, col);
+    addNeighborSeeds(row, col, 1);
 
-    int capturedStonesOut[16][2];
-    int nbCaptures = GomokuRules::checkCaptures(board, row, col, player, capturedStonesOut);
     int opponent = getOpponent(player);
+    int nbCaptures = 0;
 
-    for (int i = 0; i < nbCaptures; i++)
+    for (int d = 0; capMask != 0; d++, capMask >>= 1)
     {
-        int cr = capturedStonesOut[i][0];
-        int cc = capturedStonesOut[i][1];
+        if (!(capMask & 1))
+            continue;
+
+        for (int k = 1; k <= 2; k++)
+        {
+            int cr = row + k * CAPTURE_DIRECTIONS[d].r;
+            int cc = col + k * CAPTURE_DIRECTIONS[d].c;
 
-        record.capturedStones.push_back(CaptureInfo(cr, cc, opponent));
+            record.capturedStones[record.captureCount++] = CaptureInfo(cr, cc, opponent);
 
-        currentHash ^= zobristTable[cr][cc][opponent];
-        currentHash ^= zobristTable[cr][cc][NONE];
+            hashToggle(cr, cc, opponent, NONE);
+            stoneCount--;
 
-        board[cr][cc] = NONE;
+            board[cr][cc] = NONE;
+            planes[opponent].reset(cr, cc);
+            addNeighborSeeds(cr, cc, -1);
+            nbCaptures++;
+        }
     }
 
+    refreshCaptureIndexAround(row, col);
+    for (int i = 0; i < record.captureCount; i++)
+        refreshCaptureIndexAround(record.capturedStones[i].row,
+                                  record.capturedStones[i].col);
+
     if (player == BLACK)
         gameState.capturedByBlack += nbCaptures;
     else
         gameState.capturedByWhite += nbCaptures;
 
-    moveHistory.push(record);
+    // Mise à jour delta de l'évaluation ; une capture change les compteurs
+    // globaux dont dépendent les seuils de evaluateMoveQuick → invalidation.
+    if (nbCaptures > 0)
+        evalDirty = true;
+    else if (!evalDirty)
+        refreshEvalAround(row, col);
 }
 
 void GomokuAI::undoMove()
 {
-    if (moveHistory.empty())
+    if (undoDepth == 0)
         return;
 
-    MoveRecord lastRecord = moveHistory.top();
-    moveHistory.pop();
+    const MoveRecord &lastRecord = undoStack[--undoDepth];
 
-    currentHash ^= zobristTable[lastRecord.move.row][lastRecord.move.col][lastRecord.player];
-    currentHash ^= zobristTable[lastRecord.move.row][lastRecord.move.col][NONE];
+    hashToggle(lastRecord.move.row, lastRecord.move.col, lastRecord.player, NONE);
+    stoneCount--;
 
-    gameState = stateHistory.back();
-    stateHistory.pop_back();
+    gameState = lastRecord.state;
 
     board[lastRecord.move.row][lastRecord.move.col] = NONE;
+    planes[lastRecord.player].reset(lastRecord.move.row, lastRecord.move.col);
+    addNeighborSeeds(lastRecord.move.row, lastRecord.move.col, -1);
 
-    for (const CaptureInfo &capture : lastRecord.capturedStones)
+    for (int i = 0; i < lastRecord.captureCount; i++)
     {
-        currentHash ^= zobristTable[capture.row][capture.col][NONE];
-        currentHash ^= zobristTable[capture.row][capture.col][capture.player];
+        const CaptureInfo &capture = lastRecord.capturedStones[i];
+
+        hashToggle(capture.row, capture.col, NONE, capture.player);
+        stoneCount++;
 
         board[capture.row][capture.col] = capture.player;
+        planes[capture.player].set(capture.row, capture.col);
+        addNeighborSeeds(capture.row, capture.col, 1);
+    }
+
+    refreshCaptureIndexAround(lastRecord.move.row, lastRecord.move.col);
+    for (int i = 0; i < lastRecord.captureCount; i++)
+        refreshCaptureIndexAround(lastRecord.capturedStones[i].row,
+                                  lastRecord.capturedStones[i].col);
+
+    if (lastRecord.captureCount > 0)
+        evalDirty = true;
+    else if (!evalDirty)
+        refreshEvalAround(lastRecord.move.row, lastRecord.move.col);
+}
+
+// Transition de partie définitive (pont zéro-copie) : applique le coup et
+// ses captures en delta — plateau, plans, hash de Zobrist, compteurs de
+// capture — sans repasser par la resynchronisation complète de setBoard.
+// Le coup étant joué pour de bon, l'enregistrement d'annulation est jeté.
+void GomokuAI::applyMoveDelta(int row, int col, int player)
+{
+    if (!GomokuRules::isOnBoard(row, col) || board[row][col] != NONE)
+        return;
+
+    makeMoveInternal(row, col, player);
+
+    // Mise à jour incrémentale des caches d'arbitrage à partir de
+    // l'enregistrement du coup : pierre posée puis pierres capturées. Le coup
+    // étant définitif, l'enregistrement est dépilé sans être rejoué.
+    const MoveRecord &record = undoStack[--undoDepth];
+
+    refreshCapturabilityAround(row, col);
+    refreshFiveRunsThrough(row, col, player);
+
+    for (int i = 0; i < record.captureCount; i++)
+    {
+        refreshCapturabilityAround(record.capturedStones[i].row, record.capturedStones[i].col);
+        refreshFiveRunsThrough(record.capturedStones[i].row, record.capturedStones[i].col,
+                               record.capturedStones[i].player);
+    }
+}
+
+// =================================================================================
+//                      ARBITRAGE DE VICTOIRE (CACHES INCRÉMENTAUX)
+// =================================================================================
+//
+// L'ancien chemin d'arbitrage (GomokuRules::checkWin) balayait les 361 cases
+// et testait la prenabilité de chaque pierre de chaque ligne par une
+// simulation complète. Ici la prenabilité est un bitmap par couleur et les
+// alignements de 5 un second bitmap, tous deux entretenus en delta sur les
+// transitions de partie : l'arbitrage devient des lectures de bits plus un
+// scan des seules lignes passant par le dernier coup.
+
+void GomokuAI::refreshCapturabilityCell(int row, int col)
+{
+    for (int p = BLACK; p <= WHITE; p++)
+    {
+        if (board[row][col] == p &&
+            GomokuRules::isStoneCapturable(board, row, col, getOpponent(p)))
+            capturablePlane[p].set(row, col);
+        else
+            capturablePlane[p].reset(row, col);
+    }
+}
+
+// Une case modifiée en (row, col) ne peut changer la prenabilité que des
+// pierres à distance 1 ou 2 le long des 8 directions (le motif de paire
+// couvre les offsets -1..+2 autour de la pierre sujette).
+void GomokuAI::refreshCapturabilityAround(int row, int col)
+{
+    refreshCapturabilityCell(row, col);
+
+    for (int i = 0; i < 8; i++)
+    {
+        Direction dir = CAPTURE_DIRECTIONS[i];
+        for (int dist = 1; dist <= 2; dist++)
+        {
+            int r = row + dist * dir.r;
+            int c = col + dist * dir.c;
+            if (GomokuRules::isOnBoard(r, c) && board[r][c] != NONE)
+                refreshCapturabilityCell(r, c);
+        }
+    }
+}
+
+// Recalcule l'appartenance à un alignement de 5 pour le segment contigu de
+// `player` contenant la pierre (row, col) sur l'axe donné.
+void GomokuAI::refreshRunSegment(int row, int col, int axis, int player)
+{
+    if (!GomokuRules::isOnBoard(row, col) || board[row][col] != player)
+        return;
+
+    int dr = AXES[axis].r;
+    int dc = AXES[axis].c;
+
+    int r0 = row, c0 = col;
+    while (GomokuRules::isOnBoard(r0 - dr, c0 - dc) && board[r0 - dr][c0 - dc] == player)
+    {
+        r0 -= dr;
+        c0 -= dc;
+    }
+
+    int length = 0;
+    int r = r0, c = c0;
+    while (GomokuRules::isOnBoard(r, c) && board[r][c] == player)
+    {
+        length++;
+        r += dr;
+        c += dc;
+    }
+
+    r = r0;
+    c = c0;
+    for (int i = 0; i < length; i++, r += dr, c += dc)
+    {
+        if (length >= 5)
+            fiveRun[player].set(r, c);
+        else
+            fiveRun[player].reset(r, c);
+    }
+}
+
+// (row, col) vient de changer d'occupation : réévalue les segments de
+// `player` qui la contiennent ou la jouxtent sur les 4 axes. Une pose peut
+// fusionner deux segments ; un retrait (capture) scinde un segment en deux.
+void GomokuAI::refreshFiveRunsThrough(int row, int col, int player)
+{
+    if (board[row][col] != player)
+        fiveRun[player].reset(row, col);
+
+    for (int a = 0; a < 4; a++)
+    {
+        if (board[row][col] == player)
+        {
+            refreshRunSegment(row, col, a, player);
+        }
+        else
+        {
+            refreshRunSegment(row - AXES[a].r, col - AXES[a].c, a, player);
+            refreshRunSegment(row + AXES[a].r, col + AXES[a].c, a, player);
+        }
+    }
+}
+
+void GomokuAI::rebuildArbiterCaches()
+{
+    capturablePlane[BLACK].clear();
+    capturablePlane[WHITE].clear();
+    fiveRun[BLACK].clear();
+    fiveRun[WHITE].clear();
+
+    for (int r = 0; r < BOARD_SIZE; r++)
+        for (int c = 0; c < BOARD_SIZE; c++)
+        {
+            int p = board[r][c];
+            if (p == NONE)
+                continue;
+
+            refreshCapturabilityCell(r, c);
+            for (int a = 0; a < 4; a++)
+                refreshRunSegment(r, c, a, p);
+        }
+}
+
+// Arbitrage du coup qui vient d'être joué : pierre déjà posée, compteurs de
+// capture à jour. Même sémantique que GomokuRules::checkWinAt avec
+// lastMovePlayer == player (seul un alignement sans pierre prenable gagne),
+// la prenabilité étant lue dans le bitmap au lieu d'être resimulée.
+bool GomokuAI::checkWinAtCached(int row, int col, int player)
+{
+    if (getCaptures(player) >= MAX_CAPTURE_STONES)
+        return true;
+
+    if (!GomokuRules::isOnBoard(row, col) || board[row][col] != player)
+        return false;
+
+    bool isBreakable = capturablePlane[player].test(row, col);
+
+    for (int a = 0; a < 4; a++)
+    {
+        int count = 1;
+
+        for (int sense = -1; sense <= 1; sense += 2)
+        {
+            int r = row + sense * AXES[a].r;
+            int c = col + sense * AXES[a].c;
+
+            while (GomokuRules::isOnBoard(r, c) && board[r][c] == player)
+            {
+                if (!isBreakable && capturablePlane[player].test(r, c))
+                    isBreakable = true;
+                count++;
+                r += sense * AXES[a].r;
+                c += sense * AXES[a].c;
+            }
+        }
+
+        if (count >= 5 && !isBreakable)
+            return true;
     }
+    return false;
 }
 
-void GomokuAI::makeMove(int row, int col, int player)
+// Arbitrage global pour `player` sans balayage du plateau : l'existence d'un
+// alignement est lue dans fiveRun. Pour le joueur qui n'a pas le trait, tout
+// alignement vaut victoire (l'adversaire a eu l'occasion de le casser et ne
+// l'a pas fait) ; pour le joueur au trait, il faut un alignement sans pierre
+// prenable, vérifié depuis les seules pierres marquées.
+bool GomokuAI::checkWinCached(int player, int lastMovePlayer)
 {
-    if (GomokuRules::isOnBoard(row, col))
+    if (getCaptures(player) >= MAX_CAPTURE_STONES)
+        return true;
+
+    if (!fiveRun[player].any())
+        return false;
+
+    if (player != lastMovePlayer)
+        return true;
+
+    for (int w = 0; w < BB_WORDS; w++)
     {
-        board[row][col] = player;
-        currentHash ^= zobristTable[row][col][NONE];
-        currentHash ^= zobristTable[row][col][player];
+        uint64_t word = fiveRun[player].bits[w];
+        while (word)
+        {
+            int idx = w * 64 + __builtin_ctzll(word);
+            word &= word - 1;
+
+            if (checkWinAtCached(idx / BOARD_SIZE, idx % BOARD_SIZE, player))
+                return true;
+        }
     }
+    return false;
 }
\ No newline at end of file
@@ -3,20 +3,88 @@
 #define GOMOKU_AI_H
 
 #include <vector>
-#include <stack>
-#include <unordered_map>
+#include <chrono>
+#include <random>
 #include "gomoku_rules.h"
+#include "gomoku_bitboard.h"
+
+// Les threads de recherche (Lazy SMP) sont disponibles en natif et dans les
+// builds emcc compilés avec -s USE_PTHREADS (cible wasm-threads du Makefile).
+#if defined(__EMSCRIPTEN_PTHREADS__) || !defined(__EMSCRIPTEN__)
+#define GOMOKU_THREADS 1
+#endif
 
 class GomokuAI;
 
 // Access to the singleton instance
 GomokuAI *getGlobalAI();
 
+// Redimensionne la table de transposition (arrondi à la puissance de 2
+// d'entrées inférieure). La table est allouée à plat, taille fixe.
+void resizeTranspositionTable(int mb);
+
+// Nombre de threads de recherche (1 = séquentiel). Plafonné à 1 si le build
+// ne supporte pas les threads.
+void setSearchThreads(int threads);
+
+// Dos d'évaluation des feuilles, partagé par toutes les instances (thread
+// principal et auxiliaires SMP) : barème statique par défaut, ou parties
+// aléatoires courtes (playouts) pour le service d'analyse.
+const int EVAL_STATIC = 0;
+const int EVAL_PLAYOUT = 1;
+
+void setEvaluationMode(int mode);
+
+// Enveloppe de force à l'exécution : budget de nœuds par recherche (0 =
+// illimité), profondeur maximale et largeur de candidats racine/feuille
+// (0 = défauts de compilation). Un même binaire sert ainsi des produits
+// aux enveloppes CPU différentes.
+void setSearchBudget(long long nodes, int maxDepth, int maxCandidates);
+
+// Annulation coopérative de la recherche en cours : drapeau atomique armé
+// depuis n'importe quel thread, relevé par le test d'horloge amorti de
+// minimax. La recherche rend alors son meilleur coup courant, comme à
+// l'épuisement du budget temps.
+void cancelActiveSearch();
+
+// Instantané de progression, publié en continu par le thread de recherche
+// principal dans un tampon lisible sans appel (exposé tel quel par le pont) :
+// [0] séquence, [1] dernière profondeur terminée, [2] ligne et [3] colonne du
+// meilleur coup, [4] score racine, [5] nœuds, [6] recherche en cours (0/1).
+// Écriture mono-thread, lecture tolérante au déchirement.
+const int SEARCH_PROGRESS_SLOTS = 8;
+extern int searchProgressBuffer[SEARCH_PROGRESS_SLOTS];
+
+// Statistiques brutes de la dernière recherche du thread principal (les
+// auxiliaires SMP ne comptent pas). Remplies en continu ; consommées par le
+// banc de mesure natif.
+struct SearchStats
+{
+    long long nodes;
+    long long ttProbes;
+    long long ttHits;
+    long long cutoffs; // coupures bêta (taux = cutoffs / nodes)
+    int depthReached;
+    double iterationMs[32]; // temps cumulé pour terminer chaque profondeur
+
+    void reset()
+    {
+        nodes = ttProbes = ttHits = cutoffs = 0;
+        depthReached = 0;
+        for (int i = 0; i < 32; i++)
+            iterationMs[i] = 0.0;
+    }
+};
+
+extern SearchStats searchStats;
+
+// Vue dépaquetée d'une entrée de la table de transposition (résultat de probe)
 struct TTEntry
 {
     int depth;
     int score;
-    int flag; // 0: EXACT, 1: ALPHA, 2: BETA
+    int flag;     // 0: EXACT, 1: ALPHA, 2: BETA
+    int bestMove; // row * BOARD_SIZE + col, -1 si absent
 };
 
 struct Move
@@ -58,42 +126,184 @@ struct CaptureInfo
     CaptureInfo(int r = 0, int c = 0, int p = 0) : row(r), col(c), player(p) {}
 };
 
-struct MoveRecord
-{
-    Move move;
-    std::vector<CaptureInfo> capturedStones;
-    int player;
-
-    MoveRecord(const Move &m, int p = NONE) : move(m), player(p) {}
-};
-
 struct GameState
 {
     int capturedByBlack, capturedByWhite;
     GameState() : capturedByBlack(0), capturedByWhite(0) {}
 };
 
+// Profondeur make/undo maximale (recherche + quiescence + large marge) et
+// nombre de listes de coups par pli. Dimensionne les structures à capacité
+// fixe du chemin de recherche : zéro allocation entre la racine et la feuille.
+const int MAX_SEARCH_PLY = 64;
+const int PLY_LIST_COUNT = 32;
+
+// Enregistrement d'annulation à capacité fixe : un coup capture au plus
+// 16 pierres par construction (8 directions × une paire).
+struct MoveRecord
+{
+    Move move;
+    int player;
+    int captureCount;
+    CaptureInfo capturedStones[16];
+    GameState state; // compteurs de capture avant le coup
+};
+
 class GomokuAI
 {
 private:
     int board[BOARD_SIZE][BOARD_SIZE];
+
+    // Plans d'occupation compactés (index = couleur), maintenus en parallèle
+    // du plateau pour les scans de lignes des chemins chauds.
+    BitBoard planes[3];
+
+    // Ensemble de candidats incrémental : pour chaque case, nombre de pierres
+    // dans son voisinage 5×5, et masque des cases à compteur non nul.
+    // Maintenu par make/undo ; la génération de candidats devient une
+    // itération du masque, la légalité n'étant vérifiée que paresseusement
+    // pour les coups qui survivent au tri.
+    uint8_t neighborCount[BOARD_SIZE][BOARD_SIZE];
+    BitBoard candidateMask;
+
+    void addNeighborSeeds(int row, int col, int delta);
+    void rebuildNeighborCounts();
+
+    // Index de capture incrémental : pour chaque case et chaque couleur, le
+    // masque 8 bits des directions où poser cette couleur capturerait une
+    // paire (bit d ↔ CAPTURE_DIRECTIONS[d]). Maintenu par make/undo — seules
+    // les cases dont le motif passe par une case modifiée sont recalculées —
+    // la sonde de capture des chemins chauds devient une lecture d'octet.
+    uint8_t captureDirMask[3][BOARD_SIZE][BOARD_SIZE];
+
+    void rebuildCaptureIndex();
+    void refreshCaptureIndexCell(int row, int col);
+    void refreshCaptureBit(int row, int col, int d);
+    void refreshCaptureIndexAround(int row, int col);
+
+    // Pierres que `player` capturerait en jouant (row, col) : deux par
+    // direction armée. Équivalent de GomokuRules::checkCaptures en une
+    // lecture (la case elle-même n'entre pas dans le motif).
+    int captureCount(int player, int row, int col) const
+    {
+        return 2 * __builtin_popcount(captureDirMask[player][row][col]);
+    }
+
+    // Ordonnancement des coups : killers par profondeur (2 slots) et table
+    // d'historique [joueur][case], alimentés par les coupures bêta. Essayés
+    // avant toute évaluation heuristique, avec le meilleur coup de la table
+    // de transposition en tête.
+    int killerMoves[32][2];
+    int historyTable[3][BOARD_SIZE][BOARD_SIZE];
+
+    void recordCutoff(int depth, int player, int moveIdx);
+    void resetSearchContext();
+
     std::vector<Move> aiCandidateMoves;
 
     int aiPlayer, humanPlayer;
-    int currentHash;
+    uint64_t currentHash;
+
+    // Images du hash sous les 7 symétries non triviales du plateau (rotations
+    // et miroirs), maintenues incrémentalement au même rythme que currentHash.
+    // En phase d'ouverture, la clé TT canonique est le minimum des 8 : les
+    // 8 orientations d'une même position partagent alors leurs entrées.
+    uint64_t symHashes[7];
+    int stoneCount; // pierres posées (maintenu par make/undo/setBoard)
+
+    void hashToggle(int row, int col, int from, int to);
+    uint64_t canonicalKey(int &sym) const;
 
     GameState gameState;
 
-    std::stack<MoveRecord> moveHistory;
-    std::vector<GameState> stateHistory;
+    // Pile d'annulation et listes de coups par pli, toutes deux à capacité
+    // fixe : le chemin de recherche n'alloue jamais (les vecteurs ne
+    // subsistent qu'à la racine, une fois par tour).
+    MoveRecord undoStack[MAX_SEARCH_PLY];
+    int undoDepth;
+    Move plyMoves[PLY_LIST_COUNT][BOARD_SIZE * BOARD_SIZE];
 
     // Direction vectors: horizontal, vertical, diagonal, anti-diagonal
     const int dx[4] = {1, 0, 1, 1};
     const int dy[4] = {0, 1, 1, -1};
 
-    int minimax(int depth, int alpha, int beta, int player);
-
-    std::vector<Move> getCandidateMoves(int player);
+    // Budget temps de la recherche (approfondissement itératif)
+    std::chrono::steady_clock::time_point searchDeadline;
+    bool searchAborted;
+    int timeCheckCounter;
+
+    // Score racine de la dernière recherche (consommé par le mode batch)
+    int lastSearchScore;
+
+    // Évaluation incrémentale : contribution en cache de chaque pierre posée
+    // (et la couleur pour laquelle elle a été calculée), sommée par couleur.
+    // make/undo ne rafraîchit que les 4 axes passant par les cases modifiées ;
+    // un événement de capture invalide tout (les seuils de capture de
+    // evaluateMoveQuick dépendent des compteurs globaux).
+    int cellContribution[BOARD_SIZE][BOARD_SIZE];
+    int cellContribColor[BOARD_SIZE][BOARD_SIZE];
+    long long evalSum[3];
+    bool evalDirty;
+
+    void rebuildEvaluation();
+    void refreshEvalCell(int row, int col);
+    void refreshEvalAround(int row, int col);
+
+    // Caches d'arbitrage de victoire, tenus à jour sur les transitions de
+    // partie (applyMoveDelta / setBoard) seulement — jamais sur le make/undo
+    // de la recherche, qui ne les lit pas. capturablePlane : pierres prenables
+    // en paire ; fiveRun : pierres appartenant à un alignement d'au moins 5.
+    BitBoard capturablePlane[3];
+    BitBoard fiveRun[3];
+
+    void rebuildArbiterCaches();
+    void refreshCapturabilityCell(int row, int col);
+    void refreshCapturabilityAround(int row, int col);
+    void refreshRunSegment(int row, int col, int axis, int player);
+    void refreshFiveRunsThrough(int row, int col, int player);
+
+    // Instance auxiliaire Lazy SMP : ne touche ni au singleton global, ni à
+    // la génération de la table de transposition.
+    bool isHelper;
+
+    int minimax(int depth, int alpha, int beta, int player, bool allowNull = true);
+    int quiescence(int alpha, int beta, int player, int qdepth);
+
+    // Recherche dans l'espace des menaces (VCF) : seuls les coups forçants
+    // de l'attaquant et les parades réelles du défenseur sont développés.
+    // Lancée avant la recherche générale ; voir la section dédiée du .cpp.
+    bool threatSpaceSearch(int budgetMs, int &outRow, int &outCol);
+    bool threatWin(int depth, int attacker);
+    int fiveCompletions(int row, int col, int player, int *out);
+
+    std::chrono::steady_clock::time_point threatDeadline;
+    bool threatAborted;
+    bool threatDepthLimited; // une ligne a buté sur l'horizon de l'itération
+    int threatCheckCounter;
+    int threatRow, threatCol; // coup gagnant remonté par threatWin
+
+    // Solveur de course aux captures : quand un camp est à deux paires de
+    // MAX_CAPTURE_STONES, seuls les coups qui capturent (attaquant) et les
+    // vraies parades (défenseur) sont développés, avec mémoïsation dans une
+    // petite table dédiée. Voir la section du .cpp.
+    bool captureRaceSearch(int budgetMs, int &outRow, int &outCol);
+    bool raceWin(int depth, int attacker);
+
+    bool raceDepthLimited;
+    int raceRow, raceCol; // coup gagnant remonté par raceWin
+
+
+    bool searchRootIteration(int depth, std::vector<Move> &candidates, int &outRow, int &outCol);
+    void helperSearch(int startDepth, std::chrono::steady_clock::time_point deadline);
+
+    int getCandidateMoves(int player, Move *out);
+
+    // Évaluation par playouts : liste de coups scratch dédiée (les listes
+    // par pli sont vivantes dans les cadres minimax appelants) et générateur
+    // local, pour une boucle sans allocation ni partage.
+    int evaluatePlayouts(int player);
+    Move playoutMoves[BOARD_SIZE * BOARD_SIZE];
+    std::mt19937 playoutRng;
 
     // move and board evaluation
     int evaluateBoard(int player);
@@ -107,22 +317,72 @@ private:
 
 
 public:
-    GomokuAI(int aiPlayerColor);
+    // registerGlobal publie l'instance comme moteur du pont (globalAI) ;
+    // helper la marque auxiliaire Lazy SMP : pas de statistiques, de budget
+    // de nœuds ni de publication de progression — seul le pool interne le
+    // demande. Les instances annexes (livre, rejeu, tournoi) passent
+    // simplement registerGlobal = false.
+    GomokuAI(int aiPlayerColor, bool registerGlobal = true, bool helper = false);
 
     void clearBoard();
     void setBoard(const int *flatBoard, int blackCaptures, int whiteCaptures);
 
-    void makeMove(int row, int col, int player);
+    void applyMoveDelta(int row, int col, int player);
     bool isValidMove(int row, int col);
 
     void getBestMove(int &bestRow, int &bestCol);
+    void getBestMoveTimed(int budgetMs, int &bestRow, int &bestCol);
+
+    // Réflexion sur le temps adverse (builds avec threads ; no-op sinon).
+    // startPondering lance un auxiliaire sur la position courante — réponse
+    // adverse prédite par la table de transposition jouée d'avance — qui
+    // réchauffe la table partagée jusqu'à stopPondering / ponderHit.
+    void startPondering();
+    void stopPondering();
+    void ponderHit();
+    void ponderLoop(); // corps du thread auxiliaire
+
+    // Arbitrage de victoire sur l'état vivant (le coup arbitré est déjà
+    // appliqué) : prenabilité lue dans le bitmap en cache, scan limité aux
+    // lignes passant par le coup / aux alignements marqués dans fiveRun.
+    bool checkWinAtCached(int row, int col, int player);
+    bool checkWinCached(int player, int lastMovePlayer);
+
+    // Variation principale reconstruite depuis la table de transposition en
+    // suivant les meilleurs coups depuis la position courante (au plus maxLen
+    // coups, écrits en row * BOARD_SIZE + col). Appelée à la demande par la
+    // surface d'instrumentation — coût nul pendant la recherche.
+    int extractPV(int *out, int maxLen);
+
+    // Comptage de nœuds perft sur make/undo (vérification de non-régression :
+    // le plateau, les plans et le hash doivent revenir à l'identique)
+    long long perft(int depth, int player);
+
+    uint64_t getHash() const
+    {
+        return currentHash;
+    }
+
+    // Évaluation statique de la position courante du point de vue de
+    // `player` (étiquetage des passes de replay natif, voir gomoku_bench)
+    int evaluatePosition(int player)
+    {
+        return evaluateBoard(player);
+    }
+
+    int getLastSearchScore() const
+    {
+        return lastSearchScore;
+    }
 
     const int (*getBoard() const)[BOARD_SIZE]
     {
         return board;
     }
 
-    const std::vector<Move> getCandidates() const
+    // Référence directe (sans copie) : le pont expose data() + size() à JS,
+    // Move étant un agrégat de 4 int lisible tel quel via HEAP32.
+    const std::vector<Move> &getCandidates() const
     {
         return aiCandidateMoves;
     }
@@ -0,0 +1,850 @@
+// =================================================================================
+//                      BANC DE MESURE NATIF (cible `make bench`)
+// =================================================================================
+//
+// Binaire natif autonome pour profiler et valider le moteur hors WASM :
+//
+//   ./gomoku_bench                 banc sur la suite de positions (500 ms/position)
+//   ./gomoku_bench --budget 2000   banc avec budget personnalisé
+//   ./gomoku_bench --perft N       comptage de nœuds perft (profondeur N) sur la
+//                                  suite, avec vérification de la restauration
+//                                  du hash après make/undo
+//   ./gomoku_bench --book-build N OUT
+//                                  distille N parties de self-play en un livre
+//                                  d'ouvertures binaire (--budget = temps par
+//                                  coup, en ms)
+//   ./gomoku_bench --book PATH     charge un livre avant le banc (les sondes
+//                                  se font dans getBestMoveTimed)
+//   ./gomoku_bench --records-build N OUT
+//                                  enregistre N parties de self-play au format
+//                                  compact (9 bits/coup, voir gomoku_record.h)
+//   ./gomoku_bench --replay PATH [--labels OUT]
+//                                  rejoue un fichier de parties en flux via la
+//                                  mécanique make/undo et mesure le débit ;
+//                                  avec --labels, émet une étiquette
+//                                  d'évaluation par position (entraînement)
+//   ./gomoku_bench --tournament N [--jobs J] [--engine-a SPEC] [--engine-b SPEC]
+//                                  tournoi A/B de N parties entre deux
+//                                  configurations moteur (SPEC :
+//                                  budget=MS,nodes=N,depth=D,cand=C,eval=E),
+//                                  réparties sur J threads ; rapporte le
+//                                  différentiel Elo avec intervalle de
+//                                  confiance et le débit agrégé
+//
+// Rapporte nœuds/s, taux de hits de la table de transposition, et le temps
+// pour terminer chaque profondeur de l'approfondissement itératif.
+
+#include "gomoku_ai.h"
+#include "gomoku_book.h"
+#include "gomoku_record.h"
+#include "gomoku_rules.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+struct BenchStone
+{
+    int row, col, player;
+};
+
+struct BenchPosition
+{
+    const char *name;
+    int toMove;
+    int blackCaptures, whiteCaptures;
+    const BenchStone *stones;
+    int stoneCount;
+};
+
+// Positions de milieu de partie calmes, volontairement figées : tout
+// changement de comportement du moteur doit se voir dans les chiffres, pas
+// dans les entrées. Aucun camp n'y dispose de victoire immédiate, de blocage
+// forcé ni de combinaison forçante : chaque position doit traverser
+// l'approfondissement itératif complet (runBench échoue si une recherche
+// rend zéro nœud).
+
+static const BenchStone POS1[] = {
+    {9, 9, 1}, {9, 10, 2}, {8, 9, 2}, {10, 10, 1}, {8, 8, 1}, {11, 11, 2}, {8, 10, 2}, {10, 8, 1}, {7, 9, 1}, {11, 9, 2}, {12, 10, 1}, {10, 9, 2}};
+
+static const BenchStone POS2[] = {
+    {9, 9, 1}, {8, 9, 2}, {9, 10, 1}, {9, 8, 2}, {10, 10, 1}, {11, 11, 2}, {8, 10, 2}, {7, 10, 2}, {10, 8, 1}, {11, 7, 2}, {10, 9, 2}, {7, 11, 1}, {12, 6, 1}, {6, 12, 2}, {10, 11, 2}, {10, 12, 1}, {11, 9, 1}, {12, 9, 2}};
+
+static const BenchStone POS3[] = {
+    {3, 3, 1}, {3, 4, 2}, {4, 4, 2}, {4, 5, 1}, {5, 5, 1}, {5, 6, 2}, {15, 15, 1}, {14, 14, 2}, {15, 14, 1}, {14, 15, 2}, {6, 6, 1}, {2, 2, 2}, {13, 13, 1}, {16, 16, 2}, {6, 7, 1}, {7, 6, 2}, {12, 12, 1}, {12, 13, 2}, {5, 4, 1}, {4, 3, 2}, {13, 14, 1}, {13, 12, 2}};
+
+static const BenchPosition SUITE[] = {
+    {"milieu-serre", 2, 0, 0, POS1, (int)(sizeof(POS1) / sizeof(POS1[0]))},
+    {"milieu-ouvert", 1, 2, 0, POS2, (int)(sizeof(POS2) / sizeof(POS2[0]))},
+    {"double-front", 2, 0, 2, POS3, (int)(sizeof(POS3) / sizeof(POS3[0]))}};
+
+static const int SUITE_SIZE = (int)(sizeof(SUITE) / sizeof(SUITE[0]));
+
+static void loadPosition(GomokuAI &ai, const BenchPosition &pos)
+{
+    int flat[BOARD_SIZE * BOARD_SIZE];
+    memset(flat, 0, sizeof(flat));
+
+    for (int i = 0; i < pos.stoneCount; i++)
+        flat[pos.stones[i].row * BOARD_SIZE + pos.stones[i].col] = pos.stones[i].player;
+
+    ai.setBoard(flat, pos.blackCaptures, pos.whiteCaptures);
+}
+
+static int runBench(int budgetMs)
+{
+    printf("=== Banc moteur : %d positions, budget %d ms ===\n\n", SUITE_SIZE, budgetMs);
+
+    long long totalNodes = 0;
+    double totalMs = 0.0;
+    int invalid = 0;
+
+    for (int p = 0; p < SUITE_SIZE; p++)
+    {
+        const BenchPosition &pos = SUITE[p];
+        GomokuAI ai(pos.toMove);
+        loadPosition(ai, pos);
+
+        auto start = std::chrono::steady_clock::now();
+        int row, col;
+        ai.getBestMoveTimed(budgetMs, row, col);
+        double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+        double hitRate = searchStats.ttProbes > 0
+                             ? 100.0 * searchStats.ttHits / searchStats.ttProbes
+                             : 0.0;
+
+        printf("[%s] coup (%d,%d) en %.1f ms\n", pos.name, row, col, ms);
+        printf("  noeuds       : %lld (%.0f kn/s)\n",
+               searchStats.nodes, searchStats.nodes / (ms > 0.0 ? ms : 1.0));
+        printf("  TT           : %lld hits / %lld probes (%.1f%%)\n",
+               searchStats.ttHits, searchStats.ttProbes, hitRate);
+        printf("  profondeur   : %d\n", searchStats.depthReached);
+        printf("  temps/prof.  : ");
+        for (int d = 1; d <= searchStats.depthReached && d < 32; d++)
+            printf("d%d=%.0fms ", d, searchStats.iterationMs[d]);
+        printf("\n\n");
+
+        // Une position résolue sans explorer un seul nœud (victoire
+        // immédiate, blocage forcé, combinaison forçante) ne mesure rien :
+        // le banc refuse de rendre des chiffres vides.
+        if (searchStats.nodes == 0)
+        {
+            fprintf(stderr, "ERREUR: [%s] 0 noeud explore, la position ne mesure rien\n",
+                    pos.name);
+            invalid++;
+        }
+
+        totalNodes += searchStats.nodes;
+        totalMs += ms;
+    }
+
+    printf("=== Total : %lld noeuds, %.0f kn/s ===\n",
+           totalNodes, totalNodes / (totalMs > 0.0 ? totalMs : 1.0));
+    return invalid > 0 ? 1 : 0;
+}
+
+static int runPerft(int depth)
+{
+    printf("=== Perft profondeur %d ===\n\n", depth);
+
+    int failures = 0;
+
+    for (int p = 0; p < SUITE_SIZE; p++)
+    {
+        const BenchPosition &pos = SUITE[p];
+        GomokuAI ai(pos.toMove);
+        loadPosition(ai, pos);
+
+        uint64_t hashBefore = ai.getHash();
+
+        auto start = std::chrono::steady_clock::now();
+        long long nodes = ai.perft(depth, pos.toMove);
+        double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+        bool hashOk = (ai.getHash() == hashBefore);
+        if (!hashOk)
+            failures++;
+
+        printf("[%s] %lld noeuds en %.1f ms (%.0f kn/s) — hash %s\n",
+               pos.name, nodes, ms, nodes / (ms > 0.0 ? ms : 1.0),
+               hashOk ? "OK" : "CORROMPU");
+    }
+
+    printf("\n%s\n", failures == 0 ? "perft OK" : "perft : restauration du hash cassée");
+    return failures == 0 ? 0 : 1;
+}
+
+// ---------------------------------------------------------------------------------
+// Construction du livre d'ouvertures : self-play, agrégation par clé
+// (hash + trait), distillation du coup le plus profitable par position.
+// ---------------------------------------------------------------------------------
+
+// Résultat agrégé d'un coup de livre candidat
+struct BookTally
+{
+    int games;
+    int weight; // 2 * victoires + nulles du camp au trait
+
+    BookTally() : games(0), weight(0) {}
+};
+
+struct BookSample
+{
+    uint64_t key;
+    uint16_t move;
+    int side;
+};
+
+// Les deux premiers plis sont tirés au hasard dans le carré central 7×7
+// (déterministe par index de partie) : sans cela, un moteur déterministe
+// rejouerait la même partie N fois.
+static const int BOOK_RANDOM_PLIES = 2;
+static const int BOOK_MAX_GAME_PLIES = 120;
+
+static int runBookBuild(int games, const char *outPath, int budgetMs)
+{
+    printf("=== Construction du livre : %d parties, %d ms/coup ===\n\n",
+           games, budgetMs);
+
+    std::map<uint64_t, std::map<uint16_t, BookTally>> tallies;
+
+    for (int g = 0; g < games; g++)
+    {
+        GomokuAI black(BLACK, false);
+        GomokuAI white(WHITE, false);
+        std::mt19937 rng(1000 + g);
+
+        std::vector<BookSample> samples;
+        int winner = NONE;
+
+        for (int ply = 0; ply < BOOK_MAX_GAME_PLIES; ply++)
+        {
+            int side = (ply % 2 == 0) ? BLACK : WHITE;
+            GomokuAI &mover = (side == BLACK) ? black : white;
+
+            int row = -1, col = -1;
+            if (ply < BOOK_RANDOM_PLIES)
+            {
+                // Tirage central (revalidé : la case peut être prise)
+                for (int tries = 0; tries < 64 && row < 0; tries++)
+                {
+                    int r = BOARD_SIZE / 2 - 3 + (int)(rng() % 7);
+                    int c = BOARD_SIZE / 2 - 3 + (int)(rng() % 7);
+                    if (GomokuRules::validateMove(
+                            const_cast<int (*)[BOARD_SIZE]>(mover.getBoard()),
+                            r, c, side) == VALID)
+                    {
+                        row = r;
+                        col = c;
+                    }
+                }
+            }
+            else
+            {
+                uint64_t key = bookKey(mover.getHash(), side);
+                mover.getBestMoveTimed(budgetMs, row, col);
+
+                if (row >= 0 && ply <= BOOK_MAX_STONES)
+                    samples.push_back({key, (uint16_t)(row * BOARD_SIZE + col),
+                                       side});
+            }
+
+            if (row < 0)
+                break; // aucun coup légal : nulle
+
+            black.applyMoveDelta(row, col, side);
+            white.applyMoveDelta(row, col, side);
+
+            if (black.checkWinAtCached(row, col, side))
+            {
+                winner = side;
+                break;
+            }
+        }
+
+        for (const BookSample &s : samples)
+        {
+            BookTally &t = tallies[s.key][s.move];
+            t.games++;
+            if (winner == s.side)
+                t.weight += 2;
+            else if (winner == NONE)
+                t.weight += 1;
+        }
+
+        printf("partie %d/%d : %s (%zu positions échantillonnées)\n",
+               g + 1, games,
+               winner == BLACK ? "noir gagne"
+                               : (winner == WHITE ? "blanc gagne" : "nulle"),
+               samples.size());
+    }
+
+    // Distillation : pour chaque clé, le coup au meilleur bilan (les coups
+    // qui n'ont jamais au moins annulé sont écartés). std::map garantit
+    // l'ordre des clés exigé par la recherche dichotomique de la sonde.
+    std::vector<BookEntry> entries;
+    for (const auto &pos : tallies)
+    {
+        const BookTally *best = nullptr;
+        uint16_t bestMove = 0;
+        for (const auto &cand : pos.second)
+        {
+            if (best == nullptr || cand.second.weight > best->weight ||
+                (cand.second.weight == best->weight &&
+                 cand.second.games > best->games))
+            {
+                best = &cand.second;
+                bestMove = cand.first;
+            }
+        }
+        if (best == nullptr || best->weight == 0)
+            continue;
+
+        BookEntry e;
+        e.key = pos.first;
+        e.move = bestMove;
+        e.weight = (uint16_t)(best->weight > 65535 ? 65535 : best->weight);
+        e.games = (uint32_t)best->games;
+        entries.push_back(e);
+    }
+
+    FILE *f = fopen(outPath, "wb");
+    if (f == nullptr)
+    {
+        fprintf(stderr, "impossible d'ouvrir %s en écriture\n", outPath);
+        return 1;
+    }
+
+    BookHeader header = {BOOK_MAGIC, BOOK_VERSION, (uint32_t)entries.size(), 0};
+    fwrite(&header, sizeof(header), 1, f);
+    if (!entries.empty())
+        fwrite(entries.data(), sizeof(BookEntry), entries.size(), f);
+    fclose(f);
+
+    printf("\n=== Livre : %zu entrées → %s ===\n", entries.size(), outPath);
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------
+// Parties compactes : génération par self-play et replay en flux
+// ---------------------------------------------------------------------------------
+
+static int runRecordsBuild(int games, const char *outPath, int budgetMs)
+{
+    printf("=== Enregistrement : %d parties, %d ms/coup ===\n\n", games, budgetMs);
+
+    GameRecordWriter writer;
+    if (!writer.open(outPath))
+    {
+        fprintf(stderr, "impossible d'ouvrir %s en écriture\n", outPath);
+        return 1;
+    }
+
+    for (int g = 0; g < games; g++)
+    {
+        GomokuAI black(BLACK, false);
+        GomokuAI white(WHITE, false);
+        std::mt19937 rng(2000 + g);
+
+        int moves[BOOK_MAX_GAME_PLIES];
+        int moveCount = 0;
+        int winner = NONE;
+
+        for (int ply = 0; ply < BOOK_MAX_GAME_PLIES; ply++)
+        {
+            int side = (ply % 2 == 0) ? BLACK : WHITE;
+            GomokuAI &mover = (side == BLACK) ? black : white;
+
+            int row = -1, col = -1;
+            if (ply < BOOK_RANDOM_PLIES)
+            {
+                for (int tries = 0; tries < 64 && row < 0; tries++)
+                {
+                    int r = BOARD_SIZE / 2 - 3 + (int)(rng() % 7);
+                    int c = BOARD_SIZE / 2 - 3 + (int)(rng() % 7);
+                    if (GomokuRules::validateMove(
+                            const_cast<int (*)[BOARD_SIZE]>(mover.getBoard()),
+                            r, c, side) == VALID)
+                    {
+                        row = r;
+                        col = c;
+                    }
+                }
+            }
+            else
+            {
+                mover.getBestMoveTimed(budgetMs, row, col);
+            }
+
+            if (row < 0)
+                break; // aucun coup légal : nulle
+
+            moves[moveCount++] = row * BOARD_SIZE + col;
+            black.applyMoveDelta(row, col, side);
+            white.applyMoveDelta(row, col, side);
+
+            if (black.checkWinAtCached(row, col, side))
+            {
+                winner = side;
+                break;
+            }
+        }
+
+        int result = (winner == BLACK) ? RECORD_BLACK_WINS
+                                       : (winner == WHITE ? RECORD_WHITE_WINS
+                                                          : RECORD_DRAW);
+        writer.append(moves, moveCount, result);
+
+        printf("partie %d/%d : %d coups, %s\n", g + 1, games, moveCount,
+               winner == BLACK ? "noir gagne"
+                               : (winner == WHITE ? "blanc gagne" : "nulle"));
+    }
+
+    uint32_t written = writer.games();
+    if (!writer.close())
+    {
+        fprintf(stderr, "écriture de %s incomplète\n", outPath);
+        return 1;
+    }
+
+    printf("\n=== %u parties → %s ===\n", written, outPath);
+    return 0;
+}
+
+static int runReplay(const char *path, const char *labelsPath)
+{
+    GameRecordReader reader;
+    if (!reader.open(path))
+    {
+        fprintf(stderr, "fichier de parties invalide : %s\n", path);
+        return 1;
+    }
+
+    FILE *labels = nullptr;
+    if (labelsPath != nullptr)
+    {
+        labels = fopen(labelsPath, "w");
+        if (labels == nullptr)
+        {
+            fprintf(stderr, "impossible d'ouvrir %s en écriture\n", labelsPath);
+            return 1;
+        }
+    }
+
+    printf("=== Replay : %u parties (%s) ===\n\n", reader.games(), path);
+
+    // Une seule instance : clearBoard entre les parties, coups appliqués en
+    // delta — aucun rehachage, aucune validation redondante (les fichiers
+    // sortent de la mécanique make/undo elle-même).
+    GomokuAI ai(BLACK, false);
+
+    long long totalGames = 0;
+    long long totalPositions = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    GameView game;
+    while (reader.next(game))
+    {
+        ai.clearBoard();
+
+        for (int i = 0; i < game.moveCount; i++)
+        {
+            int idx = game.move(i);
+            int side = (i % 2 == 0) ? BLACK : WHITE;
+
+            ai.applyMoveDelta(idx / BOARD_SIZE, idx % BOARD_SIZE, side);
+            totalPositions++;
+
+            if (labels != nullptr)
+            {
+                // Étiquette du point de vue du camp qui vient de jouer
+                fprintf(labels, "%lld %d %d %d %d\n", totalGames, i, idx,
+                        ai.evaluatePosition(side), game.result);
+            }
+        }
+        totalGames++;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+
+    if (labels != nullptr)
+        fclose(labels);
+    reader.close();
+
+    printf("%lld parties, %lld positions en %.1f ms (%.0f parties/s, %.0f pos/s)\n",
+           totalGames, totalPositions, ms,
+           totalGames / (ms > 0.0 ? ms : 1.0) * 1000.0,
+           totalPositions / (ms > 0.0 ? ms : 1.0) * 1000.0);
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------
+// Tournoi A/B : deux configurations moteur s'affrontent sur N parties, les
+// couleurs alternant à chaque partie et les deux premiers plis tirés au
+// hasard comme pour la construction du livre. Les parties, indépendantes,
+// sont réparties sur J threads par un compteur partagé : les tâches étant de
+// coût homogène, ce partage atomique rend le même service qu'une file à vol
+// de travail, sans la machinerie.
+// ---------------------------------------------------------------------------------
+
+// Configuration d'un camp : budget temps par coup (par appel, donc sûr en
+// parallèle) et enveloppe de force / dos d'évaluation (statiques processus :
+// s'ils diffèrent entre les camps, le tournoi est ramené à un seul thread et
+// les réglages sont rebasculés avant chaque coup).
+struct EngineConfig
+{
+    int budgetMs = 50;
+    long long nodes = 0;
+    int maxDepth = 0;
+    int maxCandidates = 0;
+    int evalMode = EVAL_STATIC;
+};
+
+static bool parseEngineSpec(const char *spec, EngineConfig &cfg)
+{
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", spec);
+
+    for (char *tok = strtok(buf, ","); tok != nullptr; tok = strtok(nullptr, ","))
+    {
+        char *eq = strchr(tok, '=');
+        if (eq == nullptr)
+            return false;
+        *eq = '\0';
+        long value = atol(eq + 1);
+
+        if (strcmp(tok, "budget") == 0)
+            cfg.budgetMs = (int)value;
+        else if (strcmp(tok, "nodes") == 0)
+            cfg.nodes = value;
+        else if (strcmp(tok, "depth") == 0)
+            cfg.maxDepth = (int)value;
+        else if (strcmp(tok, "cand") == 0)
+            cfg.maxCandidates = (int)value;
+        else if (strcmp(tok, "eval") == 0)
+            cfg.evalMode = (int)value;
+        else
+            return false;
+    }
+    return true;
+}
+
+static void applyEngineConfig(const EngineConfig &cfg)
+{
+    setSearchBudget(cfg.nodes, cfg.maxDepth, cfg.maxCandidates);
+    setEvaluationMode(cfg.evalMode);
+}
+
+static bool globalKnobsDiffer(const EngineConfig &a, const EngineConfig &b)
+{
+    return a.nodes != b.nodes || a.maxDepth != b.maxDepth ||
+           a.maxCandidates != b.maxCandidates || a.evalMode != b.evalMode;
+}
+
+static int runTournament(int games, int jobs, const EngineConfig &cfgA,
+                         const EngineConfig &cfgB)
+{
+    bool switchPerMove = globalKnobsDiffer(cfgA, cfgB);
+
+    // L'enveloppe de force et le dos d'évaluation sont des statiques
+    // processus : deux réglages ne peuvent pas être servis en parallèle. Un
+    // budget de nœuds non plus, même identique : il se mesure sur le
+    // compteur global searchStats, partagé entre threads.
+    if ((switchPerMove || cfgA.nodes > 0 || cfgB.nodes > 0) && jobs > 1)
+    {
+        printf("réglages globaux par camp : tournoi ramené à 1 thread\n");
+        jobs = 1;
+    }
+    if (jobs < 1)
+        jobs = 1;
+    if (jobs > games)
+        jobs = games;
+
+    printf("=== Tournoi : %d parties, %d thread(s) ===\n", games, jobs);
+    printf("A : budget=%d ms nodes=%lld depth=%d cand=%d eval=%d\n",
+           cfgA.budgetMs, cfgA.nodes, cfgA.maxDepth, cfgA.maxCandidates, cfgA.evalMode);
+    printf("B : budget=%d ms nodes=%lld depth=%d cand=%d eval=%d\n",
+           cfgB.budgetMs, cfgB.nodes, cfgB.maxDepth, cfgB.maxCandidates, cfgB.evalMode);
+    printf("(table de transposition partagée entre les camps : les écarts de\n"
+           " profondeur pure sont amortis — comparer de préférence des budgets)\n\n");
+
+    if (!switchPerMove)
+        applyEngineConfig(cfgA);
+
+    std::atomic<int> nextGame(0);
+    std::atomic<int> winsA(0), winsB(0), draws(0);
+    std::atomic<long long> totalNodes(0), totalSearchUs(0);
+    std::mutex printMutex;
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto playWorker = [&]()
+    {
+        for (int g = nextGame.fetch_add(1); g < games; g = nextGame.fetch_add(1))
+        {
+            // Alternance des couleurs : A prend NOIR sur les parties paires
+            int blackIsA = (g % 2 == 0);
+
+            // Instances locales non publiées : registerGlobal = true ferait
+            // écrire globalAI depuis chaque thread et y laisserait un pointeur
+            // pendant à la fin de la partie. Non auxiliaires pour autant — le
+            // comptage et le budget de nœuds passent par searchStats
+            GomokuAI black(BLACK, false);
+            GomokuAI white(WHITE, false);
+
+            // Ouvertures appariées : chaque ouverture (graine g/2) est jouée
+            // deux fois, couleurs échangées — le biais du trait s'annule
+            std::mt19937 rng(3000 + g / 2);
+
+            int winner = NONE;
+            long long gameNodes = 0;
+
+            for (int ply = 0; ply < BOOK_MAX_GAME_PLIES; ply++)
+            {
+                int side = (ply % 2 == 0) ? BLACK : WHITE;
+                GomokuAI &mover = (side == BLACK) ? black : white;
+                bool moverIsA = (side == BLACK) == (blackIsA != 0);
+                const EngineConfig &cfg = moverIsA ? cfgA : cfgB;
+
+                int row = -1, col = -1;
+                if (ply < BOOK_RANDOM_PLIES)
+                {
+                    for (int tries = 0; tries < 64 && row < 0; tries++)
+                    {
+                        int r = BOARD_SIZE / 2 - 3 + (int)(rng() % 7);
+                        int c = BOARD_SIZE / 2 - 3 + (int)(rng() % 7);
+                        if (GomokuRules::validateMove(
+                                const_cast<int (*)[BOARD_SIZE]>(mover.getBoard()),
+                                r, c, side) == VALID)
+                        {
+                            row = r;
+                            col = c;
+                        }
+                    }
+                }
+                else
+                {
+                    if (switchPerMove)
+                        applyEngineConfig(cfg);
+
+                    auto moveStart = std::chrono::steady_clock::now();
+                    mover.getBestMoveTimed(cfg.budgetMs, row, col);
+                    totalSearchUs += std::chrono::duration_cast<std::chrono::microseconds>(
+                                         std::chrono::steady_clock::now() - moveStart)
+                                         .count();
+                    // searchStats est un global partagé : en parallèle le
+                    // compteur est indicatif (jamais utilisé pour le verdict)
+                    gameNodes += searchStats.nodes;
+                }
+
+                if (row < 0)
+                    break; // aucun coup légal : nulle
+
+                black.applyMoveDelta(row, col, side);
+                white.applyMoveDelta(row, col, side);
+
+                if (black.checkWinAtCached(row, col, side))
+                {
+                    winner = side;
+                    break;
+                }
+            }
+
+            totalNodes += gameNodes;
+
+            const char *verdict;
+            if (winner == NONE)
+            {
+                draws++;
+                verdict = "nulle";
+            }
+            else if ((winner == BLACK) == (blackIsA != 0))
+            {
+                winsA++;
+                verdict = "A gagne";
+            }
+            else
+            {
+                winsB++;
+                verdict = "B gagne";
+            }
+
+            std::lock_guard<std::mutex> lock(printMutex);
+            printf("partie %d/%d : %s (A en %s)\n", g + 1, games, verdict,
+                   blackIsA ? "noir" : "blanc");
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < jobs; t++)
+        workers.emplace_back(playWorker);
+    playWorker();
+    for (std::thread &t : workers)
+        t.join();
+
+    double totalMs = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    // Retour aux défauts : le tournoi ne doit pas laisser traîner une
+    // enveloppe réduite dans le processus
+    applyEngineConfig(EngineConfig());
+
+    int wA = winsA.load(), wB = winsB.load(), d = draws.load();
+    int played = wA + wB + d;
+
+    printf("\n=== Résultat : A %d / B %d / nulles %d (%d parties) ===\n",
+           wA, wB, d, played);
+
+    // Différentiel Elo : score moyen s = (victoires + nulles/2) / N, écart
+    // type empirique des scores par partie, intervalle à 95 % propagé à
+    // travers la courbe logistique.
+    if (played > 0)
+    {
+        double s = (wA + 0.5 * d) / played;
+        double var = (wA * (1.0 - s) * (1.0 - s) +
+                      d * (0.5 - s) * (0.5 - s) +
+                      wB * s * s) /
+                     played;
+        double margin = 1.96 * sqrt(var / played);
+
+        double lo = s - margin;
+        double hi = s + margin;
+
+        // Bornes écrêtées à l'intérieur de (0, 1) pour rester finies
+        const double EPS = 1e-6;
+        if (lo < EPS)
+            lo = EPS;
+        if (hi > 1.0 - EPS)
+            hi = 1.0 - EPS;
+
+        if (s <= EPS || s >= 1.0 - EPS)
+            printf("Elo : différentiel hors échelle (score %.3f)\n", s);
+        else
+            printf("Elo : %+.1f [%+.1f, %+.1f] à 95%% (score %.3f)\n",
+                   400.0 * log10(s / (1.0 - s)),
+                   400.0 * log10(lo / (1.0 - lo)),
+                   400.0 * log10(hi / (1.0 - hi)), s);
+    }
+
+    double searchMs = totalSearchUs.load() / 1000.0;
+    printf("débit : %lld noeuds en %.0f ms de recherche (%.0f kn/s agrégé, "
+           "%.1f parties/min)\n",
+           totalNodes.load(), searchMs,
+           totalNodes.load() / (searchMs > 0.0 ? searchMs : 1.0),
+           played / (totalMs > 0.0 ? totalMs : 1.0) * 60000.0);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int budgetMs = 500;
+    int perftDepth = 0;
+    int bookGames = 0;
+    const char *bookOut = nullptr;
+    const char *bookPath = nullptr;
+    int recordGames = 0;
+    const char *recordOut = nullptr;
+    const char *replayPath = nullptr;
+    const char *labelsPath = nullptr;
+    int tournamentGames = 0;
+    int tournamentJobs = (int)std::thread::hardware_concurrency();
+    EngineConfig engineA, engineB;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc)
+            budgetMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--perft") == 0 && i + 1 < argc)
+            perftDepth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--book-build") == 0 && i + 2 < argc)
+        {
+            bookGames = atoi(argv[++i]);
+            bookOut = argv[++i];
+        }
+        else if (strcmp(argv[i], "--book") == 0 && i + 1 < argc)
+            bookPath = argv[++i];
+        else if (strcmp(argv[i], "--records-build") == 0 && i + 2 < argc)
+        {
+            recordGames = atoi(argv[++i]);
+            recordOut = argv[++i];
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            replayPath = argv[++i];
+        else if (strcmp(argv[i], "--labels") == 0 && i + 1 < argc)
+            labelsPath = argv[++i];
+        else if (strcmp(argv[i], "--tournament") == 0 && i + 1 < argc)
+            tournamentGames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc)
+            tournamentJobs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--engine-a") == 0 && i + 1 < argc)
+        {
+            if (!parseEngineSpec(argv[++i], engineA))
+            {
+                fprintf(stderr, "spec moteur invalide : %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else if (strcmp(argv[i], "--engine-b") == 0 && i + 1 < argc)
+        {
+            if (!parseEngineSpec(argv[++i], engineB))
+            {
+                fprintf(stderr, "spec moteur invalide : %s\n", argv[i]);
+                return 2;
+            }
+        }
+        else
+        {
+            fprintf(stderr,
+                    "usage: %s [--budget MS] [--perft DEPTH] "
+                    "[--book-build GAMES OUT] [--book PATH] "
+                    "[--records-build GAMES OUT] [--replay PATH [--labels OUT]] "
+                    "[--tournament GAMES [--jobs J] [--engine-a SPEC] [--engine-b SPEC]]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    if (bookPath != nullptr)
+    {
+        if (!openingBook.loadFile(bookPath))
+        {
+            fprintf(stderr, "livre invalide : %s\n", bookPath);
+            return 1;
+        }
+        printf("livre chargé : %u entrées (%s)\n\n", openingBook.size(), bookPath);
+    }
+
+    if (tournamentGames > 0)
+        return runTournament(tournamentGames, tournamentJobs, engineA, engineB);
+
+    if (bookGames > 0)
+        return runBookBuild(bookGames, bookOut, budgetMs);
+
+    if (recordGames > 0)
+        return runRecordsBuild(recordGames, recordOut, budgetMs);
+
+    if (replayPath != nullptr)
+        return runReplay(replayPath, labelsPath);
+
+    if (perftDepth > 0)
+        return runPerft(perftDepth);
+
+    return runBench(budgetMs);
+}
@@ -0,0 +1,159 @@
+#ifndef GOMOKU_BITBOARD_H
+#define GOMOKU_BITBOARD_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "gomoku_rules.h"
+
+// =================================================================================
+//                              BITBOARD (PLANS D'OCCUPATION)
+// =================================================================================
+//
+// Les 361 intersections sont compactées dans 6 mots de 64 bits par couleur
+// (index = row * BOARD_SIZE + col). Les scans de lignes deviennent des
+// extractions de fenêtres 2-bits-par-case au lieu de boucles par cellule
+// avec tests isOnBoard.
+
+const int BB_WORDS = 6;
+
+struct BitBoard
+{
+    uint64_t bits[BB_WORDS];
+
+    void clear()
+    {
+        memset(bits, 0, sizeof(bits));
+    }
+
+    bool any() const
+    {
+        for (int i = 0; i < BB_WORDS; i++)
+            if (bits[i])
+                return true;
+        return false;
+    }
+
+    bool test(int row, int col) const
+    {
+        int idx = row * BOARD_SIZE + col;
+        return (bits[idx >> 6] >> (idx & 63)) & 1;
+    }
+
+    void set(int row, int col)
+    {
+        int idx = row * BOARD_SIZE + col;
+        bits[idx >> 6] |= (uint64_t)1 << (idx & 63);
+    }
+
+    void reset(int row, int col)
+    {
+        int idx = row * BOARD_SIZE + col;
+        bits[idx >> 6] &= ~((uint64_t)1 << (idx & 63));
+    }
+};
+
+// Encodage d'une cellule dans une fenêtre extraite : 2 bits par case.
+enum WindowCell
+{
+    WIN_EMPTY = 0,
+    WIN_OWN = 1,
+    WIN_BLOCK = 2 // pierre adverse OU hors plateau
+};
+
+// Extrait jusqu'à 19 bits consécutifs d'un plan à partir de l'index `start`
+// (une ligne horizontale est contiguë dans le bitboard).
+static inline uint32_t extractBits(const BitBoard &b, int start, int count)
+{
+    int w = start >> 6;
+    int s = start & 63;
+
+    uint64_t v = b.bits[w] >> s;
+    if (s + count > 64 && w + 1 < BB_WORDS)
+        v |= b.bits[w + 1] << (64 - s);
+
+    return (uint32_t)(v & (((uint32_t)1 << count) - 1));
+}
+
+// Dispersion de Morton : écarte 16 bits sur les positions paires d'un mot de
+// 32 bits (le bit i passe au bit 2i).
+static inline uint32_t spread2(uint32_t x)
+{
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+    return x;
+}
+
+// Motif WIN_BLOCK répété sur `count` cases (2 bits par case)
+static inline uint32_t blockRun(int count)
+{
+    return 0xAAAAAAAAu & (((uint32_t)1 << (2 * count)) - 1);
+}
+
+// Chemin rapide horizontal : la fenêtre est un champ de bits contigu dans
+// chaque plan — deux extractions de mot et deux dispersions remplacent la
+// boucle case par case. Les cases hors plateau deviennent des WIN_BLOCK
+// plaqués aux extrémités.
+static inline uint32_t packWindowRow(const BitBoard &own, const BitBoard &opp,
+                                     int row, int col, int span)
+{
+    int lo = (col - span < 0) ? 0 : col - span;
+    int hi = (col + span > BOARD_SIZE - 1) ? BOARD_SIZE - 1 : col + span;
+    int count = hi - lo + 1;
+    int start = row * BOARD_SIZE + lo;
+
+    uint32_t ownBits = extractBits(own, start, count);
+    uint32_t oppBits = extractBits(opp, start, count);
+
+    uint32_t key = (spread2(ownBits) * WIN_OWN) | (spread2(oppBits) * WIN_BLOCK);
+
+    int prefix = lo - (col - span);
+    int suffix = (col + span) - hi;
+
+    key <<= 2 * prefix;
+    key |= blockRun(prefix);
+    if (suffix > 0)
+        key |= blockRun(suffix) << (2 * (2 * span + 1 - suffix));
+
+    return key;
+}
+
+// Extrait les cases aux offsets [-span..+span] le long de AXES[dir] passant
+// par (row, col), compactées à 2 bits par case (offset -span dans les bits
+// de poids faible). L'axe horizontal passe par l'extraction de mot ; les
+// autres axes (bits espacés de 18/19/20) gardent la passe générique, sans
+// branchement isOnBoard par case.
+static inline uint32_t packWindow(const BitBoard &own, const BitBoard &opp,
+                                  int row, int col, Direction dir, int span)
+{
+    if (dir.r == 0 && dir.c == 1)
+        return packWindowRow(own, opp, row, col, span);
+
+    uint32_t key = 0;
+    int r = row - span * dir.r;
+    int c = col - span * dir.c;
+
+    for (int i = 0; i <= 2 * span; i++, r += dir.r, c += dir.c)
+    {
+        uint32_t v = WIN_BLOCK;
+        if ((unsigned)r < (unsigned)BOARD_SIZE && (unsigned)c < (unsigned)BOARD_SIZE)
+        {
+            if (own.test(r, c))
+                v = WIN_OWN;
+            else if (!opp.test(r, c))
+                v = WIN_EMPTY;
+        }
+        key |= v << (2 * i);
+    }
+    return key;
+}
+
+// Lit le champ 2 bits de la case i d'une fenêtre compactée.
+static inline uint32_t windowCell(uint32_t key, int i)
+{
+    return (key >> (2 * i)) & 3;
+}
+
+#endif
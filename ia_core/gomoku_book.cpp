@@ -0,0 +1,160 @@
+#include "gomoku_book.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef __EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+OpeningBook openingBook;
+
+bool OpeningBook::validate(const uint8_t *data, size_t size)
+{
+    if (data == nullptr || size < sizeof(BookHeader))
+        return false;
+
+    BookHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != BOOK_MAGIC || header.version != BOOK_VERSION)
+        return false;
+
+    if (size < sizeof(BookHeader) + (size_t)header.count * sizeof(BookEntry))
+        return false;
+
+    entries = (const BookEntry *)(data + sizeof(BookHeader));
+    entryCount = header.count;
+    return true;
+}
+
+bool OpeningBook::install(const uint8_t *data, size_t size)
+{
+    close();
+
+    if (!validate(data, size))
+    {
+        entries = nullptr;
+        entryCount = 0;
+        return false;
+    }
+
+    mapping = data;
+    mappingSize = size;
+    mapped = false; // tampon externe : pas à nous de le libérer
+    owned = false;
+    return true;
+}
+
+bool OpeningBook::loadFile(const char *path)
+{
+    close();
+
+#ifndef __EMSCRIPTEN__
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(BookHeader))
+        {
+            void *addr = mmap(nullptr, (size_t)st.st_size, PROT_READ,
+                              MAP_PRIVATE, fd, 0);
+            ::close(fd);
+
+            if (addr != MAP_FAILED)
+            {
+                if (validate((const uint8_t *)addr, (size_t)st.st_size))
+                {
+                    mapping = (const uint8_t *)addr;
+                    mappingSize = (size_t)st.st_size;
+                    mapped = true;
+                    owned = false;
+                    return true;
+                }
+                munmap(addr, (size_t)st.st_size);
+                return false;
+            }
+        }
+        else
+        {
+            ::close(fd);
+        }
+    }
+#endif
+
+    // Repli (ou chemin unique en WASM) : lecture complète en mémoire
+    FILE *f = fopen(path, "rb");
+    if (f == nullptr)
+        return false;
+
+    fseek(f, 0, SEEK_END);
+    long fileSize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    if (fileSize < (long)sizeof(BookHeader))
+    {
+        fclose(f);
+        return false;
+    }
+
+    uint8_t *buffer = (uint8_t *)malloc((size_t)fileSize);
+    size_t bytesRead = fread(buffer, 1, (size_t)fileSize, f);
+    fclose(f);
+
+    if (bytesRead != (size_t)fileSize || !validate(buffer, (size_t)fileSize))
+    {
+        free(buffer);
+        entries = nullptr;
+        entryCount = 0;
+        return false;
+    }
+
+    mapping = buffer;
+    mappingSize = (size_t)fileSize;
+    mapped = false;
+    owned = true; // malloc : close() libère via free
+    return true;
+}
+
+void OpeningBook::close()
+{
+    if (mapping != nullptr)
+    {
+#ifndef __EMSCRIPTEN__
+        if (mapped)
+            munmap((void *)mapping, mappingSize);
+#endif
+        if (owned)
+            free((void *)mapping);
+        // Les tampons install() appartiennent à l'hôte : rien à libérer.
+    }
+
+    mapping = nullptr;
+    mappingSize = 0;
+    mapped = false;
+    owned = false;
+    entries = nullptr;
+    entryCount = 0;
+}
+
+int OpeningBook::probe(uint64_t key) const
+{
+    uint32_t lo = 0;
+    uint32_t hi = entryCount;
+
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (entries[mid].key < key)
+            lo = mid + 1;
+        else if (entries[mid].key > key)
+            hi = mid;
+        else
+            return (int)entries[mid].move;
+    }
+    return -1;
+}
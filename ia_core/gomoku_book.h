@@ -0,0 +1,104 @@
+#ifndef GOMOKU_BOOK_H
+#define GOMOKU_BOOK_H
+
+#include <cstdint>
+#include <cstddef>
+
+#include "gomoku_rules.h"
+
+// =================================================================================
+//                              LIVRE D'OUVERTURES
+// =================================================================================
+//
+// Livre binaire compact, indexé par le hash de Zobrist de la position
+// (zobristTable est semée de façon déterministe — mt19937_64(12345) — le même
+// livre sert donc à tous les builds). Format : un en-tête suivi d'entrées de
+// 16 octets triées par clé ; la sonde est une recherche dichotomique sur un
+// tampon en lecture seule (mmap en natif, ArrayBuffer préchargé en WASM).
+//
+// Le livre est construit par le banc natif (mode --book-build) qui distille
+// des parties de self-play : voir gomoku_bench.cpp.
+
+const uint32_t BOOK_MAGIC = 0x4B424D47; // "GMBK" en petit-boutiste
+const uint32_t BOOK_VERSION = 1;
+
+// Le livre n'est sondé que tant que le plateau porte au plus ce nombre de
+// pierres : au-delà, la couverture du self-play devient anecdotique.
+const int BOOK_MAX_STONES = 10;
+
+// Le hash de Zobrist ne code pas le trait ; ce sel est replié dans la clé
+// quand BLANC est au trait pour distinguer les deux lectures d'une même
+// position. Même convention côté constructeur et côté sonde.
+const uint64_t BOOK_SIDE_SALT = 0x9E3779B97F4A7C15ULL;
+
+#pragma pack(push, 1)
+
+struct BookHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct BookEntry
+{
+    uint64_t key;    // bookKey(hash de la position, trait)
+    uint16_t move;   // row * BOARD_SIZE + col
+    uint16_t weight; // 2 * victoires + nulles du camp au trait
+    uint32_t games;  // nombre de parties ayant joué ce coup ici
+};
+
+#pragma pack(pop)
+
+// Clé de sonde : hash de la position + trait
+static inline uint64_t bookKey(uint64_t hash, int player)
+{
+    return (player == WHITE) ? hash ^ BOOK_SIDE_SALT : hash;
+}
+
+class OpeningBook
+{
+private:
+    const BookEntry *entries;
+    uint32_t entryCount;
+
+    // Tampon sous-jacent : mmap (natif) ou tampon fourni par l'hôte (WASM).
+    const uint8_t *mapping;
+    size_t mappingSize;
+    bool mapped; // mapping vient de mmap (à munmap à la fermeture)
+    bool owned;  // mapping alloué ici par le repli fread (à free)
+
+    bool validate(const uint8_t *data, size_t size);
+
+public:
+    OpeningBook() : entries(nullptr), entryCount(0),
+                    mapping(nullptr), mappingSize(0), mapped(false), owned(false) {}
+
+    // Installe un livre depuis un tampon externe (WASM : le tampon doit
+    // rester valide tant que le livre est en service). Retourne false si
+    // l'en-tête ou la taille sont invalides ; le livre courant est fermé
+    // dans tous les cas.
+    bool install(const uint8_t *data, size_t size);
+
+    // Charge un fichier livre en natif : mmap en lecture seule, repli sur
+    // une lecture complète en mémoire si mmap échoue.
+    bool loadFile(const char *path);
+
+    void close();
+
+    // Coup du livre pour cette clé (row * BOARD_SIZE + col), ou -1 si la
+    // position n'est pas couverte. L'appelant revalide toujours le coup.
+    int probe(uint64_t key) const;
+
+    uint32_t size() const
+    {
+        return entryCount;
+    }
+};
+
+// Livre global, au même titre que la table de transposition : vide (toute
+// sonde répond -1) tant que rien n'a été chargé.
+extern OpeningBook openingBook;
+
+#endif
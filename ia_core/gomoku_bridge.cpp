@@ -1,6 +1,10 @@
 #include "gomoku_ai.h"
+#include "gomoku_book.h"
 #include "gomoku_rules.h"
 
+#include <climits>
+#include <cstdlib>
+
 // =================================================================================
 //                            1. GESTION MÉMOIRE
 // =================================================================================
@@ -11,8 +15,30 @@ static int BRIDGE_BOARD_BUFFER[BOARD_SIZE * BOARD_SIZE];
 // Buffer statique pour les Captures
 static int BRIDGE_CAPTURE_BUFFER[64];
 
-// Buffer statique pour les Candidates moves (row, col, score, type)
-static int BRIDGE_CANDIDATES_MOVE[4096];
+// Buffers du mode batch (pipeline d'entraînement) : N plateaux plats en
+// entrée, compteurs de capture par position, et triplets (coup encodé,
+// score, profondeur) en sortie.
+static const int BATCH_MAX_POSITIONS = 64;
+static int BRIDGE_BATCH_BOARDS[BATCH_MAX_POSITIONS * BOARD_SIZE * BOARD_SIZE];
+static int BRIDGE_BATCH_META[BATCH_MAX_POSITIONS * 2];
+static int BRIDGE_BATCH_RESULTS[BATCH_MAX_POSITIONS * 3];
+
+// Anneau de coups partagé JS → moteur (triplets row, col, player). Le worker
+// écrit à son index d'écriture puis appelle applyQueuedMoves ; le moteur
+// consomme depuis son propre index de lecture, en delta, sans resynchroniser
+// le plateau complet.
+static const int MOVE_RING_CAPACITY = 256;
+static int BRIDGE_MOVE_RING[MOVE_RING_CAPACITY * 3];
+static int moveRingReadIndex = 0;
+
+// Tampon du livre d'ouvertures, dimensionné à la demande : le JS précharge
+// le fichier livre (ArrayBuffer), le copie ici, puis appelle loadOpeningBook.
+// Le tampon reste en service tant que le livre est installé.
+static uint8_t *BRIDGE_BOOK_BUFFER = nullptr;
+static int bridgeBookCapacity = 0;
+
+// Instantané de recherche : 8 scalaires + 32 temps d'itération + PV (32 coups)
+static int BRIDGE_SEARCH_INFO[72];
 
 extern "C"
 {
@@ -23,18 +49,78 @@ extern "C"
         return BRIDGE_BOARD_BUFFER;
     }
 
+    // Helper pour obtenir l'adresse de l'anneau de coups depuis JS
+    int *get_move_ring_buffer()
+    {
+        return BRIDGE_MOVE_RING;
+    }
+
+    // Alloue (ou réutilise) le tampon du livre d'ouvertures pour `size`
+    // octets et retourne son adresse. Le livre courant est désinstallé
+    // d'abord : il pointe dans ce tampon.
+    uint8_t *get_book_buffer(int size)
+    {
+        if (size <= 0)
+            return nullptr;
+
+        if (size > bridgeBookCapacity)
+        {
+            openingBook.close();
+            free(BRIDGE_BOOK_BUFFER);
+            BRIDGE_BOOK_BUFFER = (uint8_t *)malloc((size_t)size);
+            bridgeBookCapacity = (BRIDGE_BOOK_BUFFER != nullptr) ? size : 0;
+        }
+        return BRIDGE_BOOK_BUFFER;
+    }
+
+    // Installe le livre copié dans le tampon (size octets). Retourne le
+    // nombre d'entrées chargées, ou -1 si l'en-tête est invalide.
+    int loadOpeningBook(int size)
+    {
+        if (BRIDGE_BOOK_BUFFER == nullptr || size <= 0 || size > bridgeBookCapacity)
+            return -1;
+
+        if (!openingBook.install(BRIDGE_BOOK_BUFFER, (size_t)size))
+            return -1;
+
+        return (int)openingBook.size();
+    }
+
+    // Helpers pour les buffers du mode batch
+    int *get_batch_board_buffer()
+    {
+        return BRIDGE_BATCH_BOARDS;
+    }
+
+    int *get_batch_meta_buffer()
+    {
+        return BRIDGE_BATCH_META;
+    }
+
+    int *get_batch_result_buffer()
+    {
+        return BRIDGE_BATCH_RESULTS;
+    }
+
     // =================================================================================
     //                            2. CYCLE DE VIE DE L'IA
     // =================================================================================
 
-    void initAI(int aiPlayer)
+    // La variante de règles (VARIANT_STANDARD42 / VARIANT_FREESTYLE) est
+    // fixée ici, avant la construction de l'IA : le module embarque les
+    // instanciations des deux politiques et aiguille vers la bonne. Une
+    // partie en cours ne change jamais de variante.
+    void initAI(int aiPlayer, int variant)
     {
+        GomokuRules::setVariant(variant);
+
         GomokuAI *ai = getGlobalAI();
         if (ai != nullptr)
         {
             delete ai;
         }
         new GomokuAI(aiPlayer);
+        moveRingReadIndex = 0;
     }
 
     void setBoard(const int *flatBoard, int blackCaptures, int whiteCaptures)
@@ -46,11 +132,62 @@ extern "C"
         }
     }
 
+    void setTTSizeMB(int mb)
+    {
+        // La table ne doit pas être réallouée sous les pieds d'un ponder
+        GomokuAI *ai = getGlobalAI();
+        if (ai != nullptr)
+        {
+            ai->stopPondering();
+        }
+        resizeTranspositionTable(mb);
+    }
+
+    // Sans effet dans les builds sans support pthreads (plafonné à 1 thread)
+    void setThreadCount(int threads)
+    {
+        setSearchThreads(threads);
+    }
+
+    // Dos d'évaluation des feuilles : 0 = barème statique (défaut),
+    // 1 = playouts aléatoires (service d'analyse)
+    void setEvalMode(int mode)
+    {
+        setEvaluationMode(mode);
+    }
+
+    // Niveau de force : budget de nœuds par recherche (0 = illimité),
+    // profondeur maximale et largeur de candidats (0 = défauts). Permet de
+    // servir app grand public, tuteur et arène avec le même binaire.
+    void setSearchBudget(long nodes, int maxDepth, int maxCandidates)
+    {
+        ::setSearchBudget((long long)nodes, maxDepth, maxCandidates);
+    }
+
+    // Annulation coopérative de la recherche en cours (sans effet si aucune
+    // recherche ne tourne). Utile dès que l'appelant peut joindre le moteur
+    // pendant getBestMove : build pthreads, ou second worker sur mémoire
+    // partagée. La recherche rend son meilleur coup courant.
+    void cancelSearch()
+    {
+        cancelActiveSearch();
+    }
+
+    // Adresse du tampon de progression, rempli en continu par la recherche
+    // (voir le layout dans gomoku_ai.h). Contrairement à getSearchInfo, la
+    // lecture ne passe par aucun appel moteur : un observateur sonde la
+    // mémoire directement pendant que _getBestMove bloque le worker.
+    int *getSearchProgress()
+    {
+        return searchProgressBuffer;
+    }
+
     void cleanupAI()
     {
         GomokuAI *ai = getGlobalAI();
         if (ai != nullptr)
         {
+            ai->stopPondering();
             delete ai;
         }
     }
@@ -59,15 +196,42 @@ extern "C"
     //                            3. ACTIONS DE JEU
     // =================================================================================
 
-    void makeMove(int row, int col, int player)
+    // Application directe d'un coup en delta : plateau, hash de Zobrist et
+    // compteurs de capture mis à jour en place, sans rehachage complet
+    void applyMoveDelta(int row, int col, int player)
     {
         GomokuAI *ai = getGlobalAI();
         if (ai != nullptr)
         {
-            ai->makeMove(row, col, player);
+            ai->applyMoveDelta(row, col, player);
         }
     }
 
+    // Consomme les coups en attente dans l'anneau jusqu'à writeIndex (exclu),
+    // chacun appliqué en delta. Retourne le nombre de coups appliqués.
+    // Un writeIndex hors de [0, MOVE_RING_CAPACITY) ne croiserait jamais
+    // l'index de lecture (boucle infinie) : il est rejeté sans rien appliquer.
+    int applyQueuedMoves(int writeIndex)
+    {
+        GomokuAI *ai = getGlobalAI();
+        if (ai == nullptr)
+            return 0;
+        if (writeIndex < 0 || writeIndex >= MOVE_RING_CAPACITY)
+            return 0;
+
+        int applied = 0;
+        while (moveRingReadIndex != writeIndex)
+        {
+            int base = moveRingReadIndex * 3;
+            ai->applyMoveDelta(BRIDGE_MOVE_RING[base],
+                               BRIDGE_MOVE_RING[base + 1],
+                               BRIDGE_MOVE_RING[base + 2]);
+            moveRingReadIndex = (moveRingReadIndex + 1) % MOVE_RING_CAPACITY;
+            applied++;
+        }
+        return applied;
+    }
+
     int getBestMove()
     {
         GomokuAI *ai = getGlobalAI();
@@ -85,6 +249,87 @@ extern "C"
         return -1;
     }
 
+    // Variante avec budget temps : approfondissement itératif borné à budgetMs
+    int getBestMoveTimed(int budgetMs)
+    {
+        GomokuAI *ai = getGlobalAI();
+        if (ai == nullptr)
+            return -1;
+
+        int bestRow, bestCol;
+        ai->getBestMoveTimed(budgetMs, bestRow, bestCol);
+
+        if (bestRow >= 0 && bestCol >= 0)
+        {
+            return bestRow * 100 + bestCol;
+        }
+        return -1;
+    }
+
+    // ---------------------------------------------------------------------------------
+    // Réflexion sur le temps adverse (voir GomokuAI::startPondering). Sans
+    // effet dans les builds sans support pthreads.
+    // ---------------------------------------------------------------------------------
+
+    void startPondering()
+    {
+        GomokuAI *ai = getGlobalAI();
+        if (ai != nullptr)
+        {
+            ai->startPondering();
+        }
+    }
+
+    void stopPondering()
+    {
+        GomokuAI *ai = getGlobalAI();
+        if (ai != nullptr)
+        {
+            ai->stopPondering();
+        }
+    }
+
+    void ponderHit()
+    {
+        GomokuAI *ai = getGlobalAI();
+        if (ai != nullptr)
+        {
+            ai->ponderHit();
+        }
+    }
+
+    // Analyse N positions en un seul franchissement du pont : pour chaque
+    // plateau du buffer d'entrée (compteurs de capture dans le buffer méta),
+    // une recherche à budget fixé ; résultats compactés en triplets
+    // (row * 100 + col ou -1, score racine, profondeur atteinte). La table de
+    // transposition reste chaude d'une position à l'autre — les positions
+    // d'un même lot sont typiquement voisines. Retourne le nombre traité.
+    int analyzeBatch(int count, int budgetMsPerPosition)
+    {
+        GomokuAI *ai = getGlobalAI();
+        if (ai == nullptr)
+            return 0;
+
+        if (count < 0)
+            count = 0;
+        if (count > BATCH_MAX_POSITIONS)
+            count = BATCH_MAX_POSITIONS;
+
+        for (int i = 0; i < count; i++)
+        {
+            ai->setBoard(&BRIDGE_BATCH_BOARDS[i * BOARD_SIZE * BOARD_SIZE],
+                         BRIDGE_BATCH_META[i * 2], BRIDGE_BATCH_META[i * 2 + 1]);
+
+            int row, col;
+            ai->getBestMoveTimed(budgetMsPerPosition, row, col);
+
+            BRIDGE_BATCH_RESULTS[i * 3] = (row >= 0 && col >= 0) ? row * 100 + col : -1;
+            BRIDGE_BATCH_RESULTS[i * 3 + 1] = ai->getLastSearchScore();
+            BRIDGE_BATCH_RESULTS[i * 3 + 2] = searchStats.depthReached;
+        }
+        return count;
+    }
+
     // =================================================================================
     //                            4. MOTEUR DE RÈGLES (EXPORTS)
     // =================================================================================
@@ -101,20 +346,16 @@ extern "C"
         return (int)GomokuRules::validateMove(board, row, col, player);
     }
 
+    // Le coup arbitré a déjà été appliqué côté moteur (anneau de coups ou
+    // resynchronisation) : lecture directe de l'état vivant et des caches
+    // d'arbitrage, sans resimulation ScopedMove.
     int rules_checkWinAt(int row, int col, int player)
     {
         GomokuAI *ai = getGlobalAI();
         if (ai == nullptr)
             return 0;
 
-        auto board = const_cast<int (*)[BOARD_SIZE]>(ai->getBoard());
-
-        ScopedMove move(board, row, col, player);
-
-        int currentCaptures = ai->getCaptures(player);
-        int totalCaptures = currentCaptures + move.numCaptured;
-
-        return GomokuRules::checkWinAt(board, row, col, player, player, totalCaptures);
+        return ai->checkWinAtCached(row, col, player) ? 1 : 0;
     }
 
     int rules_checkWin(int player)
@@ -123,12 +364,7 @@ extern "C"
         if (ai == nullptr)
             return 0;
 
-        auto board = const_cast<int (*)[BOARD_SIZE]>(ai->getBoard());
-
-        int currentCaptures = ai->getCaptures(player);
-        int lastMovePlayer = ai->getOpponent(player);
-
-        return GomokuRules::checkWin(board, player, lastMovePlayer, currentCaptures);
+        return ai->checkWinCached(player, ai->getOpponent(player)) ? 1 : 0;
     }
 
     int rules_checkStalemate(int player)
@@ -167,32 +403,62 @@ extern "C"
         return BRIDGE_CAPTURE_BUFFER;
     }
 
-    int *getAiCandidateMoves()
+    // Instantané structuré de la dernière recherche, rempli uniquement à
+    // l'appel (coût nul quand personne n'interroge). Layout du buffer int32 :
+    //   [0] nœuds (plafonné à INT_MAX)   [1] sondes TT      [2] hits TT
+    //   [3] coupures bêta                [4] profondeur     [5] score racine
+    //   [6] longueur de la PV            [7] réservé
+    //   [8..39]  temps (ms, arrondi) pour terminer chaque profondeur,
+    //            indexé par profondeur (miroir de iterationMs, [8] inutilisé)
+    //   [40..71] PV (row * BOARD_SIZE + col), longueur en [6]
+    int *getSearchInfo()
     {
         GomokuAI *ai = getGlobalAI();
-        BRIDGE_CANDIDATES_MOVE[0] = 0;
-
         if (ai == nullptr)
-            return BRIDGE_CANDIDATES_MOVE;
+        {
+            BRIDGE_SEARCH_INFO[0] = -1;
+            return BRIDGE_SEARCH_INFO;
+        }
 
-        auto candidatesMoves = ai->getCandidates();
-        int count = candidatesMoves.size();
-        
-        // Sécurité overflow buffer (4 ints par move)
-        if (count > 1000) count = 1000;
+        BRIDGE_SEARCH_INFO[0] =
+            (int)(searchStats.nodes > INT_MAX ? INT_MAX : searchStats.nodes);
+        BRIDGE_SEARCH_INFO[1] =
+            (int)(searchStats.ttProbes > INT_MAX ? INT_MAX : searchStats.ttProbes);
+        BRIDGE_SEARCH_INFO[2] =
+            (int)(searchStats.ttHits > INT_MAX ? INT_MAX : searchStats.ttHits);
+        BRIDGE_SEARCH_INFO[3] =
+            (int)(searchStats.cutoffs > INT_MAX ? INT_MAX : searchStats.cutoffs);
+        BRIDGE_SEARCH_INFO[4] = searchStats.depthReached;
+        BRIDGE_SEARCH_INFO[5] = ai->getLastSearchScore();
+        BRIDGE_SEARCH_INFO[7] = 0;
 
-        BRIDGE_CANDIDATES_MOVE[0] = count;
+        for (int d = 0; d < 32; d++)
+            BRIDGE_SEARCH_INFO[8 + d] = (int)(searchStats.iterationMs[d] + 0.5);
 
-        for (int i = 0; i < count; i++)
-        {
-            int baseIdx = 1 + (i * 4);
-            BRIDGE_CANDIDATES_MOVE[baseIdx]     = candidatesMoves[i].row;
-            BRIDGE_CANDIDATES_MOVE[baseIdx + 1] = candidatesMoves[i].col;
-            BRIDGE_CANDIDATES_MOVE[baseIdx + 2] = candidatesMoves[i].score;
-            BRIDGE_CANDIDATES_MOVE[baseIdx + 3] = candidatesMoves[i].algoType;
-        }
+        BRIDGE_SEARCH_INFO[6] = ai->extractPV(&BRIDGE_SEARCH_INFO[40], 32);
+
+        return BRIDGE_SEARCH_INFO;
+    }
+
+    // Vue directe sur les candidats de la dernière recherche : Move est un
+    // agrégat de 4 int (row, col, score, algoType), lu tel quel via HEAP32
+    // côté JS. Aucune copie par élément ; valide jusqu'à la recherche suivante.
+    int *getCandidatesPtr()
+    {
+        GomokuAI *ai = getGlobalAI();
+        if (ai == nullptr)
+            return nullptr;
+
+        return (int *)ai->getCandidates().data();
+    }
+
+    int getCandidatesCount()
+    {
+        GomokuAI *ai = getGlobalAI();
+        if (ai == nullptr)
+            return 0;
 
-        return BRIDGE_CANDIDATES_MOVE;
+        return (int)ai->getCandidates().size();
     }
 
 } // extern "C"
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "gomoku_patterns.h"
+#include "gomoku_bitboard.h"
+
+uint8_t *patternTable = nullptr;
+
+// Décode le champ 2 bits de la case i d'une clé (3, jamais produit par
+// packWindow, est traité comme un blocage).
+static inline int cellAt(uint32_t key, int i)
+{
+    int v = (key >> (2 * i)) & 3;
+    return (v == 3) ? WIN_BLOCK : v;
+}
+
+// Réplique la classification scalaire de analyzePatternScore : longueur de
+// l'alignement passant par la case centrale (plafonnée à 5) et extrémités
+// ouvertes aux deux bouts.
+static uint8_t classifyAlignment(uint32_t key)
+{
+    const int center = PATTERN_WINDOW_SPAN;
+
+    int count = 1;
+    int openEnds = 0;
+
+    int i = center + 1;
+    while (i < PATTERN_WINDOW_CELLS && cellAt(key, i) == WIN_OWN && count < 5)
+    {
+        count++;
+        i++;
+    }
+    if (i < PATTERN_WINDOW_CELLS && cellAt(key, i) == WIN_EMPTY)
+        openEnds++;
+
+    i = center - 1;
+    while (i >= 0 && cellAt(key, i) == WIN_OWN && count < 5)
+    {
+        count++;
+        i--;
+    }
+    if (i >= 0 && cellAt(key, i) == WIN_EMPTY)
+        openEnds++;
+
+    return (uint8_t)(count | (openEnds << 3));
+}
+
+// Réplique la détection de free-three de GomokuRules::isFreeThree : les 4
+// motifs bornés par des cases vides, glissés sur les 6 positions de la
+// fenêtre de 11 cases.
+static bool hasFreeThree(uint32_t key)
+{
+    int window[PATTERN_WINDOW_CELLS];
+    for (int i = 0; i < PATTERN_WINDOW_CELLS; i++)
+        window[i] = cellAt(key, i);
+
+    for (int s = 0; s <= 5; s++)
+    {
+        if (window[s] != 0 || window[s + 5] != 0)
+            continue;
+
+        // 0 0 1 1 1 0
+        if (window[s + 1] == 0 && window[s + 2] == 1 && window[s + 3] == 1 && window[s + 4] == 1)
+            return true;
+
+        // 0 1 1 1 0 0
+        if (window[s + 1] == 1 && window[s + 2] == 1 && window[s + 3] == 1 && window[s + 4] == 0)
+            return true;
+
+        // 0 1 0 1 1 0
+        if (window[s + 1] == 1 && window[s + 2] == 0 && window[s + 3] == 1 && window[s + 4] == 1)
+            return true;
+
+        // 0 1 1 0 1 0
+        if (window[s + 1] == 1 && window[s + 2] == 1 && window[s + 3] == 0 && window[s + 4] == 1)
+            return true;
+    }
+
+    return false;
+}
+
+void initPatternTables()
+{
+    if (patternTable != nullptr)
+        return;
+
+    patternTable = new uint8_t[PATTERN_TABLE_SIZE];
+
+    for (uint32_t key = 0; key < (uint32_t)PATTERN_TABLE_SIZE; key++)
+    {
+        uint8_t entry = classifyAlignment(key);
+        if (hasFreeThree(key))
+            entry |= 1 << 5;
+        patternTable[key] = entry;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef GOMOKU_PATTERNS_H
+#define GOMOKU_PATTERNS_H
+
+#include <cstdint>
+
+// =================================================================================
+//                      TABLE DE MOTIFS PRÉCALCULÉE
+// =================================================================================
+//
+// Les scans de lignes (analyzePatternScore, isFreeThree) classifient une
+// fenêtre de 11 cases (±5 autour du coup) encodée à 2 bits par case —
+// exactement la clé produite par packWindow(span=5). Au lieu de re-dériver le
+// motif case par case à chaque appel, la classification complète {longueur,
+// extrémités ouvertes, free-three} est générée une fois au démarrage et lue
+// en un seul accès tableau (4 Mo, 1 octet par clé).
+
+const int PATTERN_WINDOW_SPAN = 5;
+const int PATTERN_WINDOW_CELLS = 2 * PATTERN_WINDOW_SPAN + 1;
+const int PATTERN_TABLE_SIZE = 1 << (2 * PATTERN_WINDOW_CELLS);
+
+// Octet compacté : bits 0-2 longueur d'alignement (1..5), bits 3-4 nombre
+// d'extrémités ouvertes (0..2), bit 5 présence d'un free-three sur l'axe.
+extern uint8_t *patternTable;
+
+void initPatternTables();
+
+inline int patternCount(uint8_t entry)
+{
+    return entry & 7;
+}
+
+inline int patternOpenEnds(uint8_t entry)
+{
+    return (entry >> 3) & 3;
+}
+
+inline bool patternFreeThree(uint8_t entry)
+{
+    return (entry >> 5) & 1;
+}
+
+#endif
@@ -0,0 +1,193 @@
+#include "gomoku_record.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#ifndef __EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ---------------------------------------------------------------------------------
+// Écriture
+// ---------------------------------------------------------------------------------
+
+bool GameRecordWriter::open(const char *path)
+{
+    file = fopen(path, "wb");
+    if (file == nullptr)
+        return false;
+
+    gameCount = 0;
+
+    // En-tête provisoire, finalisé par close()
+    RecordHeader header = {RECORD_MAGIC, RECORD_VERSION, 0, 0};
+    return fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+bool GameRecordWriter::append(const int *moves, int moveCount, int result)
+{
+    if (file == nullptr || moveCount < 0 || moveCount > 0xFFFF)
+        return false;
+
+    GameHeader gh;
+    gh.moveCount = (uint16_t)moveCount;
+    gh.result = (uint8_t)result;
+    gh.pad = 0;
+
+    if (fwrite(&gh, sizeof(gh), 1, file) != 1)
+        return false;
+
+    // Empaquetage 9 bits par coup, poids faible d'abord
+    size_t bytes = packedMovesBytes(moveCount);
+    uint8_t *buffer = (uint8_t *)calloc(bytes > 0 ? bytes : 1, 1);
+    for (int i = 0; i < moveCount; i++)
+    {
+        size_t bit = (size_t)i * 9;
+        uint32_t window = (uint32_t)(moves[i] & 0x1FF) << (bit & 7);
+        buffer[bit >> 3] |= (uint8_t)window;
+        buffer[(bit >> 3) + 1] |= (uint8_t)(window >> 8);
+    }
+
+    bool ok = (bytes == 0) || fwrite(buffer, 1, bytes, file) == bytes;
+    free(buffer);
+
+    if (ok)
+        gameCount++;
+    return ok;
+}
+
+bool GameRecordWriter::close()
+{
+    if (file == nullptr)
+        return false;
+
+    RecordHeader header = {RECORD_MAGIC, RECORD_VERSION, gameCount, 0};
+    bool ok = fseek(file, 0, SEEK_SET) == 0 &&
+              fwrite(&header, sizeof(header), 1, file) == 1;
+
+    fclose(file);
+    file = nullptr;
+    return ok;
+}
+
+// ---------------------------------------------------------------------------------
+// Lecture
+// ---------------------------------------------------------------------------------
+
+bool GameRecordReader::open(const char *path)
+{
+    close();
+
+#ifndef __EMSCRIPTEN__
+    int fd = ::open(path, O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(RecordHeader))
+        {
+            void *addr = mmap(nullptr, (size_t)st.st_size, PROT_READ,
+                              MAP_PRIVATE, fd, 0);
+            ::close(fd);
+
+            if (addr != MAP_FAILED)
+            {
+                mapping = (const uint8_t *)addr;
+                mappingSize = (size_t)st.st_size;
+                mapped = true;
+            }
+        }
+        else
+        {
+            ::close(fd);
+        }
+    }
+#endif
+
+    if (mapping == nullptr)
+    {
+        // Repli (ou chemin unique en WASM) : lecture complète en mémoire
+        FILE *f = fopen(path, "rb");
+        if (f == nullptr)
+            return false;
+
+        fseek(f, 0, SEEK_END);
+        long fileSize = ftell(f);
+        fseek(f, 0, SEEK_SET);
+
+        if (fileSize < (long)sizeof(RecordHeader))
+        {
+            fclose(f);
+            return false;
+        }
+
+        uint8_t *buffer = (uint8_t *)malloc((size_t)fileSize);
+        size_t bytesRead = fread(buffer, 1, (size_t)fileSize, f);
+        fclose(f);
+
+        if (bytesRead != (size_t)fileSize)
+        {
+            free(buffer);
+            return false;
+        }
+
+        mapping = buffer;
+        mappingSize = (size_t)fileSize;
+        owned = true;
+    }
+
+    RecordHeader header;
+    memcpy(&header, mapping, sizeof(header));
+
+    if (header.magic != RECORD_MAGIC || header.version != RECORD_VERSION)
+    {
+        close();
+        return false;
+    }
+
+    gameCount = header.gameCount;
+    cursor = sizeof(RecordHeader);
+    return true;
+}
+
+void GameRecordReader::close()
+{
+    if (mapping != nullptr)
+    {
+#ifndef __EMSCRIPTEN__
+        if (mapped)
+            munmap((void *)mapping, mappingSize);
+#endif
+        if (owned)
+            free((void *)mapping);
+    }
+
+    mapping = nullptr;
+    mappingSize = 0;
+    mapped = false;
+    owned = false;
+    gameCount = 0;
+    cursor = 0;
+}
+
+bool GameRecordReader::next(GameView &out)
+{
+    if (mapping == nullptr || cursor + sizeof(GameHeader) > mappingSize)
+        return false;
+
+    GameHeader gh;
+    memcpy(&gh, mapping + cursor, sizeof(gh));
+
+    size_t bytes = packedMovesBytes(gh.moveCount);
+    if (cursor + sizeof(GameHeader) + bytes > mappingSize)
+        return false; // partie tronquée
+
+    out.packed = mapping + cursor + sizeof(GameHeader);
+    out.moveCount = gh.moveCount;
+    out.result = gh.result;
+
+    cursor += sizeof(GameHeader) + bytes;
+    return true;
+}
@@ -0,0 +1,142 @@
+#ifndef GOMOKU_RECORD_H
+#define GOMOKU_RECORD_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+#include "gomoku_rules.h"
+
+// =================================================================================
+//                      FORMAT DE PARTIES COMPACTES (SELF-PLAY)
+// =================================================================================
+//
+// Flux binaire de parties pour les passes d'entraînement : un en-tête de
+// fichier, puis les parties bout à bout. Chaque coup tient sur 9 bits
+// (row * BOARD_SIZE + col < 512), empaquetés à la suite, bits de poids
+// faible d'abord. Les captures ne sont pas stockées : le rejoueur les
+// redérive via la mécanique make/undo du moteur, qui fait foi.
+//
+// La lecture est un parcours séquentiel d'un tampon en lecture seule (mmap
+// en natif, repli fread) : des fichiers de millions de parties se rejouent
+// sans jamais tenir plus d'une vue de partie en mémoire. Voir le mode
+// --replay du banc natif (gomoku_bench.cpp).
+
+const uint32_t RECORD_MAGIC = 0x52474D47; // "GMGR" en petit-boutiste
+const uint32_t RECORD_VERSION = 1;
+
+// Issue d'une partie (octet `result` de l'en-tête de partie)
+enum RecordResult
+{
+    RECORD_DRAW = 0,
+    RECORD_BLACK_WINS = 1,
+    RECORD_WHITE_WINS = 2
+};
+
+#pragma pack(push, 1)
+
+struct RecordHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t gameCount;
+    uint32_t reserved;
+};
+
+// En-tête de partie, suivi de ceil(moveCount * 9 / 8) octets de coups
+struct GameHeader
+{
+    uint16_t moveCount;
+    uint8_t result; // RecordResult
+    uint8_t pad;
+};
+
+#pragma pack(pop)
+
+// Nombre d'octets occupés par `moveCount` coups de 9 bits
+static inline size_t packedMovesBytes(int moveCount)
+{
+    return ((size_t)moveCount * 9 + 7) / 8;
+}
+
+// Lit le coup d'index i d'un bloc empaqueté (row * BOARD_SIZE + col)
+static inline int unpackMove(const uint8_t *packed, int i)
+{
+    size_t bit = (size_t)i * 9;
+    uint32_t window = packed[bit >> 3] | ((uint32_t)packed[(bit >> 3) + 1] << 8);
+    return (int)((window >> (bit & 7)) & 0x1FF);
+}
+
+// Vue sans copie d'une partie du flux
+struct GameView
+{
+    const uint8_t *packed;
+    int moveCount;
+    int result;
+
+    int move(int i) const
+    {
+        return unpackMove(packed, i);
+    }
+};
+
+// Écriture séquentielle : les parties sont ajoutées au fil de l'eau, le
+// compteur de l'en-tête de fichier est finalisé à la fermeture.
+class GameRecordWriter
+{
+private:
+    FILE *file;
+    uint32_t gameCount;
+
+public:
+    GameRecordWriter() : file(nullptr), gameCount(0) {}
+
+    bool open(const char *path);
+
+    // `moves` : coups dans l'ordre (row * BOARD_SIZE + col), trait noir au
+    // premier coup par convention
+    bool append(const int *moves, int moveCount, int result);
+
+    bool close(); // finalise l'en-tête (gameCount)
+
+    uint32_t games() const
+    {
+        return gameCount;
+    }
+};
+
+// Lecture en flux sur tampon en lecture seule (mmap natif, repli fread)
+class GameRecordReader
+{
+private:
+    const uint8_t *mapping;
+    size_t mappingSize;
+    bool mapped;
+    bool owned;
+
+    uint32_t gameCount;
+    size_t cursor; // offset de la prochaine partie
+
+public:
+    GameRecordReader() : mapping(nullptr), mappingSize(0), mapped(false),
+                         owned(false), gameCount(0), cursor(0) {}
+
+    bool open(const char *path);
+    void close();
+
+    uint32_t games() const
+    {
+        return gameCount;
+    }
+
+    // Partie suivante (vue directe dans le tampon). Retourne false en fin
+    // de flux ou sur une partie tronquée.
+    bool next(GameView &out);
+
+    void rewind()
+    {
+        cursor = sizeof(RecordHeader);
+    }
+};
+
+#endif
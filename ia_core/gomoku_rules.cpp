@@ -1,4 +1,6 @@
 #include "gomoku_rules.h"
+#include "gomoku_bitboard.h"
+#include "gomoku_patterns.h"
 #include <algorithm>
 #include <iostream>
 
@@ -35,6 +37,26 @@ static bool scanNeighborPairs(const int board[BOARD_SIZE][BOARD_SIZE], int row,
     return false;
 }
 
+// =================================================================================
+//                              0bis. VARIANTE ACTIVE
+// =================================================================================
+
+// Variante sélectionnée à l'exécution (initAI). Les points d'entrée publics
+// aiguillent une seule fois, au sommet, vers l'instanciation templée
+// correspondante ; tout le reste est résolu à la compilation.
+static int activeVariant = VARIANT_STANDARD42;
+
+void GomokuRules::setVariant(int variant)
+{
+    activeVariant = (variant == VARIANT_FREESTYLE) ? VARIANT_FREESTYLE
+                                                   : VARIANT_STANDARD42;
+}
+
+int GomokuRules::getVariant()
+{
+    return activeVariant;
+}
+
 // =================================================================================
 //                              1. PRIMITIVES & UTILITAIRES
 // =================================================================================
@@ -100,11 +122,16 @@ int GomokuRules::checkCaptures(const int board[BOARD_SIZE][BOARD_SIZE], int row,
     return captureCount;
 }
 
-int GomokuRules::applyMove(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int capturedStonesOut[][2])
+template <typename RuleSet>
+int GomokuRules::applyMoveT(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int capturedStonesOut[][2])
 {
     // 1. Pose de la pierre
     board[row][col] = player;
 
+    // Sans captures dans la variante, la pose est tout le coup
+    if (!RuleSet::Capture)
+        return 0;
+
     // 2. Calcul des captures
     int numCaptured = checkCaptures(board, row, col, player, capturedStonesOut);
 
@@ -116,6 +143,13 @@ int GomokuRules::applyMove(int board[BOARD_SIZE][BOARD_SIZE], int row, int col,
     return numCaptured;
 }
 
+int GomokuRules::applyMove(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int capturedStonesOut[][2])
+{
+    if (activeVariant == VARIANT_FREESTYLE)
+        return applyMoveT<RuleSetFreestyle>(board, row, col, player, capturedStonesOut);
+    return applyMoveT<RuleSetStandard42>(board, row, col, player, capturedStonesOut);
+}
+
 void GomokuRules::undoMove(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int capturedStonesOut[][2], int captureCount)
 {
     int opponent = (player == BLACK) ? WHITE : BLACK;
@@ -135,59 +169,31 @@ void GomokuRules::undoMove(int board[BOARD_SIZE][BOARD_SIZE], int row, int col,
 
 bool GomokuRules::isFreeThree(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col, Direction dir, int player)
 {
-    // Mapping: 0 = Empty, 1 = Player, 2 = Block/Opponent
-    int window[11];
+    // Les motifs (__PPP_, _PPP__, _P_PP_, _PP_P_) sont précalculés dans la
+    // table de motifs : une passe d'encodage de la fenêtre, une lecture.
+    if (patternTable == nullptr)
+        initPatternTables();
+
+    uint32_t key = 0;
 
-    for (int i = -5; i <= 5; i++)
+    for (int i = -PATTERN_WINDOW_SPAN; i <= PATTERN_WINDOW_SPAN; i++)
     {
         int r = row + i * dir.r;
         int c = col + i * dir.c;
 
-        if (!isOnBoard(r, c))
-        {
-            window[i + 5] = 2;
-        }
-        else
+        uint32_t v = WIN_BLOCK;
+        if (isOnBoard(r, c))
         {
             int p = board[r][c];
             if (p == player)
-                window[i + 5] = 1;
+                v = WIN_OWN;
             else if (p == NONE)
-                window[i + 5] = 0;
-            else
-                window[i + 5] = 2;
+                v = WIN_EMPTY;
         }
+        key |= v << (2 * (i + PATTERN_WINDOW_SPAN));
     }
 
-    // __PPP_ : 0 0 1 1 1 0
-    // _PPP__ : 0 1 1 1 0 0
-    // _P_PP_ : 0 1 0 1 1 0
-    // _PP_P_ : 0 1 1 0 1 0
-
-    for (int s = 0; s <= 5; s++)
-    {
-        // Tous les Free-Threes valides sont bornés par des cases vides (0)
-        if (window[s] != 0 || window[s + 5] != 0)
-            continue;
-
-        // 0 0 1 1 1 0
-        if (window[s + 1] == 0 && window[s + 2] == 1 && window[s + 3] == 1 && window[s + 4] == 1)
-            return true;
-
-        // 0 1 1 1 0 0
-        if (window[s + 1] == 1 && window[s + 2] == 1 && window[s + 3] == 1 && window[s + 4] == 0)
-            return true;
-
-        // 0 1 0 1 1 0
-        if (window[s + 1] == 1 && window[s + 2] == 0 && window[s + 3] == 1 && window[s + 4] == 1)
-            return true;
-
-        // 0 1 1 0 1 0
-        if (window[s + 1] == 1 && window[s + 2] == 1 && window[s + 3] == 0 && window[s + 4] == 1)
-            return true;
-    }
-
-    return false;
+    return patternFreeThree(patternTable[key]);
 }
 
 bool GomokuRules::checkFreeThree(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player)
@@ -267,6 +273,11 @@ bool GomokuRules::isPairSurrounded(const int board[BOARD_SIZE][BOARD_SIZE], Poin
 
 bool GomokuRules::isStoneCapturable(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int opponent)
 {
+    // Sans captures dans la variante, aucune pierre n'est prenable — tous
+    // les appelants (barème racine, lignes cassables) héritent du bon verdict
+    if (activeVariant == VARIANT_FREESTYLE)
+        return false;
+
     int subjectPlayer = (opponent == BLACK) ? WHITE : BLACK;
     return scanNeighborPairs(board, row, col, subjectPlayer, isPairSandwiched);
 }
@@ -335,13 +346,17 @@ bool GomokuRules::checkDoubleThree(const int board[BOARD_SIZE][BOARD_SIZE], int
 //                              7. ARBITRAGE
 // =================================================================================
 
-bool GomokuRules::checkWinAt(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int playerInt, int lastMovePlayer, int capturedStones)
+template <typename RuleSet>
+bool GomokuRules::checkWinAtT(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int playerInt, int lastMovePlayer, int capturedStones)
 {
-    if (capturedStones >= MAX_CAPTURE_STONES)
+    if (RuleSet::Capture && capturedStones >= MAX_CAPTURE_STONES)
         return true;
 
     int opponent = playerInt == BLACK ? WHITE : BLACK;
-    int isBreakable = isStoneCapturable(board, row, col, opponent);
+
+    // Sans captures, aucune ligne n'est cassable : le test reste faux et
+    // toute la cascade isStoneCapturable disparaît à la compilation
+    int isBreakable = RuleSet::Capture && isStoneCapturable(board, row, col, opponent);
 
     for (int dir = 0; dir < 4; dir++)
     {
@@ -352,7 +367,7 @@ bool GomokuRules::checkWinAt(const int board[BOARD_SIZE][BOARD_SIZE], int row, i
 
         while (board[r][c] == playerInt)
         {
-            if (!isBreakable && isStoneCapturable(board, r, c, opponent))
+            if (RuleSet::Capture && !isBreakable && isStoneCapturable(board, r, c, opponent))
                 isBreakable = true;
 
             count++;
@@ -364,7 +379,7 @@ bool GomokuRules::checkWinAt(const int board[BOARD_SIZE][BOARD_SIZE], int row, i
         c = col - AXES[dir].c;
         while (board[r][c] == playerInt)
         {
-            if (!isBreakable && isStoneCapturable(board, r, c, opponent))
+            if (RuleSet::Capture && !isBreakable && isStoneCapturable(board, r, c, opponent))
                 isBreakable = true;
             count++;
             r -= AXES[dir].r;
@@ -380,6 +395,13 @@ bool GomokuRules::checkWinAt(const int board[BOARD_SIZE][BOARD_SIZE], int row, i
     return false;
 }
 
+bool GomokuRules::checkWinAt(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int playerInt, int lastMovePlayer, int capturedStones)
+{
+    if (activeVariant == VARIANT_FREESTYLE)
+        return checkWinAtT<RuleSetFreestyle>(board, row, col, playerInt, lastMovePlayer, capturedStones);
+    return checkWinAtT<RuleSetStandard42>(board, row, col, playerInt, lastMovePlayer, capturedStones);
+}
+
 bool GomokuRules::checkWin(const int board[BOARD_SIZE][BOARD_SIZE], int player, int lastMovePlayer, int capturedStones)
 {
     for (int r = 0; r < BOARD_SIZE; r++)
@@ -415,22 +437,26 @@ bool GomokuRules::checkStalemate(const int board[BOARD_SIZE][BOARD_SIZE], int pl
 //                              8. VALIDATION MAÎTRE
 // =================================================================================
 
-MoveStatus GomokuRules::validateMove(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player)
+template <typename RuleSet>
+MoveStatus GomokuRules::validateMoveT(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player)
 {
     if (!isOnBoard(row, col))
         return INVALID_BOUNDS;
     if (board[row][col] != NONE)
         return INVALID_OCCUPIED;
 
+    // En freestyle, la légalité s'arrête là : balayage de capture, suicide et
+    // double-trois sont éliminés à la compilation, pas branchés par case
+    if (RuleSet::Capture || RuleSet::DoubleThree)
     {
         ScopedMove move(board, row, col, player);
 
         // Si le coup ne capture rien, on vérifie les interdictions
         if (move.numCaptured == 0)
         {
-            if (isSuicideMove(board, row, col, player))
+            if (RuleSet::Capture && isSuicideMove(board, row, col, player))
                 return INVALID_SUICIDE;
-            if (checkDoubleThree(board, row, col, player))
+            if (RuleSet::DoubleThree && checkDoubleThree(board, row, col, player))
                 return INVALID_DOUBLE_THREE;
         }
     }
@@ -438,6 +464,22 @@ MoveStatus GomokuRules::validateMove(int board[BOARD_SIZE][BOARD_SIZE], int row,
     return VALID;
 }
 
+MoveStatus GomokuRules::validateMove(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player)
+{
+    if (activeVariant == VARIANT_FREESTYLE)
+        return validateMoveT<RuleSetFreestyle>(board, row, col, player);
+    return validateMoveT<RuleSetStandard42>(board, row, col, player);
+}
+
+// Instanciations explicites des deux variantes : les appelants qui
+// connaissent leur variante à la compilation court-circuitent l'aiguillage
+template MoveStatus GomokuRules::validateMoveT<RuleSetStandard42>(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player);
+template MoveStatus GomokuRules::validateMoveT<RuleSetFreestyle>(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player);
+template int GomokuRules::applyMoveT<RuleSetStandard42>(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int capturedStonesOut[][2]);
+template int GomokuRules::applyMoveT<RuleSetFreestyle>(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int capturedStonesOut[][2]);
+template bool GomokuRules::checkWinAtT<RuleSetStandard42>(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int lastMovePlayer, int capturedStones);
+template bool GomokuRules::checkWinAtT<RuleSetFreestyle>(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int lastMovePlayer, int capturedStones);
+
 // =================================================================================
 //                              9. RAII HELPER
 // =================================================================================
@@ -43,11 +43,55 @@ const Direction AXES[4] = {
 const Direction CAPTURE_DIRECTIONS[8] = {
     {0, 1}, {0, -1}, {1, 0}, {-1, 0}, {1, 1}, {-1, -1}, {1, -1}, {-1, 1}};
 
+// =================================================================================
+//                              VARIANTES DE RÈGLES
+// =================================================================================
+//
+// Chaque règle optionnelle est un booléen de compilation dans une politique :
+// le moteur de règles est instancié une fois par variante et les
+// vérifications mortes sont éliminées par le compilateur au lieu d'être
+// branchées cellule par cellule. La variante active est choisie à l'exécution
+// (setVariant) en aiguillant vers l'instanciation correspondante.
+
+// Gomoku « 42 » : captures par paires (suicide inclus) et interdiction du
+// double-trois — la variante historique du projet, et le défaut.
+struct RuleSetStandard42
+{
+    static constexpr bool Capture = true;
+    static constexpr bool DoubleThree = true;
+};
+
+// Freestyle : cinq alignées gagnent, aucune interdiction. La légalité se
+// réduit aux bornes et à l'occupation.
+struct RuleSetFreestyle
+{
+    static constexpr bool Capture = false;
+    static constexpr bool DoubleThree = false;
+};
+
+const int VARIANT_STANDARD42 = 0;
+const int VARIANT_FREESTYLE = 1;
+
 class GomokuRules
 {
 public:
+    // Variante active : les points d'entrée non templés ci-dessous aiguillent
+    // vers l'instanciation correspondante (une branche par appel, au sommet)
+    static void setVariant(int variant);
+    static int getVariant();
+
     static MoveStatus validateMove(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player);
 
+    // Instanciations par politique de variante (définies dans le .cpp,
+    // instanciées explicitement pour les deux RuleSet) : à appeler en direct
+    // quand la variante est connue à la compilation
+    template <typename RuleSet>
+    static MoveStatus validateMoveT(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player);
+    template <typename RuleSet>
+    static int applyMoveT(int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int capturedStonesOut[][2]);
+    template <typename RuleSet>
+    static bool checkWinAtT(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col, int player, int lastMovePlayer, int capturedStones);
+
     // --- Primitives (Lecture Seule) ---
     static bool isOnBoard(int row, int col);
     static bool isEmptyCell(const int board[BOARD_SIZE][BOARD_SIZE], int row, int col);
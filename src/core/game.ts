@@ -90,13 +90,11 @@ export class GomokuGame {
     // 4. Application Mécanique (Plateau JS Local)
     this.applyMoveMechanics(row, col, this.currentPlayer, move.captures);
 
-    // 5. Synchro État Wasm
-    // On envoie l'état COMPLET du plateau et des SCORES pour garantir que le C++ est parfaitement synchro
-    await this.wasmAI.setBoard(
-      this.board.getBoardState().flat(),
-      this.blackCaptures,
-      this.whiteCaptures
-    );
+    // 5. Synchro État Wasm (delta)
+    // Le moteur applique lui-même le coup et ses captures en place (anneau de
+    // coups partagé) : pas de réupload ni de rehachage des 361 cases. Les
+    // resynchronisations complètes restent réservées à reset() et jumpTo().
+    await this.wasmAI.makeMove(row, col, this.currentPlayer);
 
     // Événements
     emitMoveMade(move);
@@ -151,11 +149,9 @@ export class GomokuGame {
     player: Player
   ): Promise<ValidationResult & { captures?: CaptureResult[] }> {
     if (!this.wasmAI) return { isValid: false, reason: "IA non prête" };
-    await this.wasmAI.setBoard(
-      this.board.getBoardState().flat(),
-      this.blackCaptures,
-      this.whiteCaptures
-    );
+
+    // Le miroir C++ est maintenu en delta par makeMove (et resynchronisé en
+    // entier par reset/jumpTo) : pas besoin de renvoyer le plateau ici.
 
     // 1. Validation
     const status = await this.wasmAI.validateMove(row, col, player);
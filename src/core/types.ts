@@ -54,6 +54,19 @@ export interface DebugMove {
   type: 0 | 1 | 2; // 0 = Candidate (Yellow), 1 = Minimax (Red), 2 = One Shot (Purple)
 }
 
+// Instantané structuré de la dernière recherche du moteur (monitoring du
+// temps de réflexion, validation des optimisations)
+export interface SearchInfo {
+  nodes: number;
+  ttProbes: number;
+  ttHits: number;
+  cutoffs: number;
+  depthReached: number;
+  score: number;
+  iterationMs: number[]; // temps cumulé pour terminer les profondeurs 1..N
+  pv: Position[]; // variation principale depuis la position courante
+}
+
 // Contrat que doivent respecter toutes les IA (Wasm wrapper ou LLM)
 export interface AIInterface {
   requestMove(gameState: GameState): Promise<Position>;
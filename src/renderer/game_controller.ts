@@ -438,7 +438,7 @@ class GameController {
 
         const startTime = performance.now();
         
-        const aiMove = await this.wasmAI.getBestMove(this.game.getGameState());
+        const aiMove = await this.wasmAI.getBestMove();
         
         const endTime = performance.now();
         this.lastAIThinkingTime = (endTime - startTime) / 1000;
@@ -546,7 +546,7 @@ class GameController {
 
     try {
         const startTime = performance.now();
-        const suggestion = await this.wasmAI.getBestMove(this.game.getGameState());
+        const suggestion = await this.wasmAI.getBestMove();
         const endTime = performance.now();
         this.lastAIThinkingTime = (endTime - startTime) / 1000;
 
@@ -1,12 +1,13 @@
 
 interface GomokuModule {
-  _initAI: (player: number) => void;
+  _initAI: (player: number, variant: number) => void;
   _setBoard: (
     ptr: number,
     blackCaptures: number,
     whiteCaptures: number
   ) => void;
-  _makeMove: (row: number, col: number, player: number) => void;
+  _applyMoveDelta: (row: number, col: number, player: number) => void;
+  _applyQueuedMoves: (writeIndex: number) => number;
   _getBestMove: () => number;
   _cleanupAI: () => void;
 
@@ -17,13 +18,29 @@ interface GomokuModule {
   _rules_checkCaptures: (row: number, col: number, player: number) => number;
   _rules_checkStalemate: (player: number) => number;
 
+  _setEvalMode: (mode: number) => void;
+  _setSearchBudget: (
+    nodes: number,
+    maxDepth: number,
+    maxCandidates: number
+  ) => void;
+  _cancelSearch: () => void;
+  _getSearchProgress: () => number;
   _get_board_buffer: () => number;
-  _getAiCandidateMoves: () => number;
+  _get_move_ring_buffer: () => number;
+  _getSearchInfo: () => number;
+  _getCandidatesPtr: () => number;
+  _getCandidatesCount: () => number;
   HEAP32: Int32Array;
 }
 
 let wasmModule: GomokuModule | null = null;
 
+// Index d'écriture dans l'anneau de coups partagé (le moteur garde son
+// propre index de lecture, remis à zéro par _initAI)
+const MOVE_RING_CAPACITY = 256;
+let moveRingWriteIndex = 0;
+
 async function loadWasmModule() {
   self.importScripts("ia_core.js");
 
@@ -76,7 +93,9 @@ self.onmessage = async (event) => {
   try {
     switch (type) {
       case "initAI":
-        wasmModule._initAI(payload.aiPlayer);
+        // variant : 0 = Gomoku 42 (captures + double-trois), 1 = freestyle
+        wasmModule._initAI(payload.aiPlayer, payload.variant || 0);
+        moveRingWriteIndex = 0;
         break;
 
       case "setBoard": {
@@ -95,28 +114,73 @@ self.onmessage = async (event) => {
       }
 
       case "makeMove": {
-        wasmModule._makeMove(payload.row, payload.col, payload.player);
+        // Écriture du triplet dans l'anneau partagé puis consommation en
+        // delta côté moteur : pas de réupload du plateau, pas de rehachage
+        const ringPtr = wasmModule._get_move_ring_buffer();
+        const base = (ringPtr >> 2) + moveRingWriteIndex * 3;
+        wasmModule.HEAP32[base] = payload.row;
+        wasmModule.HEAP32[base + 1] = payload.col;
+        wasmModule.HEAP32[base + 2] = payload.player;
+        moveRingWriteIndex = (moveRingWriteIndex + 1) % MOVE_RING_CAPACITY;
+
+        wasmModule._applyQueuedMoves(moveRingWriteIndex);
         self.postMessage({ type: "makeMove_done" });
         break;
       }
 
-      case "getBestMove": {
-        const flatBoard = payload?.flatBoard;
+      case "setEvalMode":
+        // 0 = barème statique, 1 = playouts aléatoires (service d'analyse)
+        wasmModule._setEvalMode(payload.mode);
+        self.postMessage({ type: "setEvalMode_done" });
+        break;
 
-        if (!flatBoard || !Array.isArray(flatBoard)) {
-          self.postMessage({
-            type: "error",
-            payload:
-              "flatBoard invalide ou manquant dans le payload de getBestMove",
-          });
-          break;
-        }
+      case "setSearchBudget":
+        // Enveloppe de force : nœuds (0 = illimité), profondeur max,
+        // largeur de candidats (0 = défauts)
+        wasmModule._setSearchBudget(
+          payload.nodes,
+          payload.maxDepth,
+          payload.maxCandidates
+        );
+        self.postMessage({ type: "setSearchBudget_done" });
+        break;
 
-        const ptr = wasmModule._get_board_buffer();
-        // ptr est en octets, HEAP32 est une vue int32, donc diviser par 4
-        wasmModule.HEAP32.set(flatBoard, ptr >> 2);
-        wasmModule._setBoard(ptr, 0, 0);
+      case "cancelSearch":
+        // Arme le drapeau d'annulation du moteur. Dans le build wasm
+        // mono-thread ce message n'est traité qu'entre deux recherches (le
+        // worker est bloqué pendant _getBestMove) ; avec le build pthreads,
+        // l'appel depuis un second contexte interrompt la recherche en cours
+        wasmModule._cancelSearch();
+        break;
+
+      case "getSearchProgress": {
+        // Instantané du tampon de progression publié par la recherche :
+        // [0] séquence, [1] profondeur, [2..3] meilleur coup, [4] score,
+        // [5] nœuds, [6] en cours (lecture directe, aucun appel moteur
+        // au-delà de la résolution du pointeur)
+        const ptr = wasmModule._getSearchProgress();
+        const base = ptr >> 2;
+        const heap = wasmModule.HEAP32;
 
+        self.postMessage({
+          type: "getSearchProgress_result",
+          payload: {
+            seq: heap[base],
+            depth: heap[base + 1],
+            bestRow: heap[base + 2],
+            bestCol: heap[base + 3],
+            score: heap[base + 4],
+            nodes: heap[base + 5],
+            running: heap[base + 6] === 1,
+          },
+        });
+        break;
+      }
+
+      case "getBestMove": {
+        // L'état moteur est maintenu en delta par l'anneau de coups (et
+        // resynchronisé via setBoard sur reset/saut d'historique) : aucune
+        // réécriture du plateau ici
         const result = wasmModule._getBestMove();
         const row = Math.floor(result / 100);
         const col = result % 100;
@@ -204,13 +268,14 @@ self.onmessage = async (event) => {
       }
 
       case "getDebugData": {
-        const ptr = wasmModule._getAiCandidateMoves();
-        const startIdx = ptr >> 2;
-        const count = wasmModule.HEAP32[startIdx];
-        
+        // Lecture zéro-copie : pointeur direct sur le tableau de Move du
+        // moteur (4 int32 par coup : row, col, score, algoType)
+        const ptr = wasmModule._getCandidatesPtr();
+        const count = ptr ? wasmModule._getCandidatesCount() : 0;
+
         const moves = [];
-        let cursor = startIdx + 1;
-        
+        let cursor = ptr >> 2;
+
         for (let i = 0; i < count; i++) {
             const r = wasmModule.HEAP32[cursor++];
             const c = wasmModule.HEAP32[cursor++];
@@ -224,6 +289,42 @@ self.onmessage = async (event) => {
         break;
       }
 
+      case "getSearchInfo": {
+        // Instantané de la dernière recherche, rempli côté C++ à l'appel
+        // seulement (voir le layout dans gomoku_bridge.cpp)
+        const ptr = wasmModule._getSearchInfo();
+        const base = ptr >> 2;
+        const heap = wasmModule.HEAP32;
+
+        const pvLength = heap[base + 6];
+        const pv = [];
+        for (let i = 0; i < pvLength; i++) {
+          const idx = heap[base + 40 + i];
+          pv.push({ row: Math.floor(idx / 19), col: idx % 19 });
+        }
+
+        const depthReached = heap[base + 4];
+        const iterationMs = [];
+        for (let d = 1; d <= depthReached && d < 32; d++) {
+          iterationMs.push(heap[base + 8 + d]);
+        }
+
+        self.postMessage({
+          type: "getSearchInfo_result",
+          payload: {
+            nodes: heap[base],
+            ttProbes: heap[base + 1],
+            ttHits: heap[base + 2],
+            cutoffs: heap[base + 3],
+            depthReached,
+            score: heap[base + 5],
+            iterationMs,
+            pv,
+          },
+        });
+        break;
+      }
+
       case "cleanup":
         if (wasmModule._cleanupAI) {
           wasmModule._cleanupAI();
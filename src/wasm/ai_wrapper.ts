@@ -1,4 +1,4 @@
-import { Player, Position, GameState, DebugMove } from "../core/types.js";
+import { Player, Position, DebugMove, SearchInfo } from "../core/types.js";
 
 export class WasmAI {
   private worker: Worker | null = null;
@@ -42,6 +42,12 @@ export class WasmAI {
           case "makeMove_done":
             this.resolveQuery("makeMove_done", null);
             break;
+          case "setEvalMode_done":
+            this.resolveQuery("setEvalMode_done", null);
+            break;
+          case "setSearchBudget_done":
+            this.resolveQuery("setSearchBudget_done", null);
+            break;
 
           case "bestMoveResult":
             this.resolveQuery("bestMoveResult", payload);
@@ -51,6 +57,14 @@ export class WasmAI {
             this.resolveQuery("getDebugData_result", payload);
             break;
 
+          case "getSearchInfo_result":
+            this.resolveQuery("getSearchInfo_result", payload);
+            break;
+
+          case "getSearchProgress_result":
+            this.resolveQuery("getSearchProgress_result", payload);
+            break;
+
           // --- RULES RESPONSES ---
           case "rules_validateMove_result":
           case "rules_checkWin_result":
@@ -82,9 +96,11 @@ export class WasmAI {
     }
   }
 
-  public async initAI(aiPlayer: Player): Promise<void> {
+  // variant : 0 = Gomoku 42 (défaut), 1 = freestyle (cinq alignées, sans
+  // captures ni interdictions)
+  public async initAI(aiPlayer: Player, variant: number = 0): Promise<void> {
     this.aiPlayer = aiPlayer;
-    this.worker?.postMessage({ type: "initAI", payload: { aiPlayer } });
+    this.worker?.postMessage({ type: "initAI", payload: { aiPlayer, variant } });
   }
 
   public setBoard(
@@ -103,14 +119,65 @@ export class WasmAI {
     return this.sendQuery("makeMove", "makeMove_done", { row, col, player });
   }
 
-  public getBestMove(gameState: GameState): Promise<Position> {
-    const flatBoard = gameState.board.flat();
-    return this.sendQuery("getBestMove", "bestMoveResult", { flatBoard });
+  // L'état moteur est tenu à jour en delta (makeMove → anneau de coups) :
+  // plus de réupload du plateau avant chaque recherche
+  public getBestMove(): Promise<Position> {
+    return this.sendQuery("getBestMove", "bestMoveResult", {});
   }
 
   public getDebugData(): Promise<DebugMove[]> {
     return this.sendQuery("getDebugData", "getDebugData_result", {});
   }
+
+  // Statistiques de la dernière recherche (nœuds, TT, coupures, PV, temps
+  // par itération). L'instantané n'est construit qu'à la demande : aucun
+  // coût pendant la recherche elle-même.
+  public getSearchInfo(): Promise<SearchInfo> {
+    return this.sendQuery("getSearchInfo", "getSearchInfo_result", {});
+  }
+  // Dos d'évaluation des feuilles : 0 = barème statique (défaut),
+  // 1 = playouts aléatoires. S'applique aux recherches suivantes.
+  public setEvalMode(mode: number): Promise<void> {
+    return this.sendQuery("setEvalMode", "setEvalMode_done", { mode });
+  }
+
+  // Enveloppe de force par recherche : budget de nœuds (0 = illimité),
+  // profondeur maximale et largeur de candidats (0 = défauts). Un même
+  // binaire couvre ainsi des niveaux de difficulté différents.
+  public setSearchBudget(
+    nodes: number,
+    maxDepth: number,
+    maxCandidates: number
+  ): Promise<void> {
+    return this.sendQuery("setSearchBudget", "setSearchBudget_done", {
+      nodes,
+      maxDepth,
+      maxCandidates,
+    });
+  }
+
+  // Annulation de la recherche en cours (envoi sans attente : aucune
+  // réponse n'arrivera tant que le worker est occupé). La recherche rend
+  // son meilleur coup courant via le bestMoveResult déjà en attente.
+  public cancelSearch(): void {
+    this.worker?.postMessage({ type: "cancelSearch", payload: {} });
+  }
+
+  // Progression de la recherche (profondeur terminée, meilleur coup
+  // provisoire, nœuds, en cours). Lecture directe du tampon partagé côté
+  // worker — à sonder périodiquement pendant qu'une recherche tourne.
+  public getSearchProgress(): Promise<{
+    seq: number;
+    depth: number;
+    bestRow: number;
+    bestCol: number;
+    score: number;
+    nodes: number;
+    running: boolean;
+  }> {
+    return this.sendQuery("getSearchProgress", "getSearchProgress_result", {});
+  }
+
   public async isReady(): Promise<boolean> {
     await this.workerReadyPromise;
     return this.worker !== null;